@@ -0,0 +1,44 @@
+//一次装入很多元素：逐个insert / 区间insert / 区间构造 / insert_unique：./bench_bulk_load [n]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "linked_hashmap.hpp"
+
+typedef sjtu::linked_hashmap<int, int> map_type;
+
+template<class F>
+void run(const char *name, int n, F f) {
+    auto start = std::chrono::steady_clock::now();
+    size_t size = f();
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << n / cost.count() / 1e6 << " Mops/s (size " << size << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    std::vector<map_type::value_type> values;
+    //乘一个奇数在模2^32下是一一映射，键打乱了也不会重复
+    for (int i = 0; i < n; ++i)values.push_back({(int) ((unsigned int) i * 2654435761u), i});
+
+    run("one by one ", n, [&]() {
+        map_type map;
+        for (int i = 0; i < n; ++i)map.insert(values[i]);
+        return map.size();
+    });
+    run("range insert", n, [&]() {
+        map_type map;
+        map.insert(values.begin(), values.end());
+        return map.size();
+    });
+    run("range ctor  ", n, [&]() {
+        map_type map(values.begin(), values.end());
+        return map.size();
+    });
+    run("insert_unique", n, [&]() {
+        map_type map;
+        map.insert_unique(values.begin(), values.end());
+        return map.size();
+    });
+    return 0;
+}
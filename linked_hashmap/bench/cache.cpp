@@ -0,0 +1,53 @@
+//缓存的命中率和吞吐：./bench_cache [ops] [keys]
+//访问的键服从zipf分布，每隔一段时间插入一次只访问一遍的顺序扫描
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include "lru_cache.hpp"
+
+template<class Cache>
+void run(const char *name, size_t capacity, const int *trace, int ops) {
+    Cache cache(capacity);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        if (cache.get(trace[i]) == nullptr)cache.put(trace[i], i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> cost = end - start;
+    std::cout << name << " capacity " << capacity << ": hit rate "
+              << (double) cache.hits() / (cache.hits() + cache.misses())
+              << ", " << ops / cost.count() / 1e6 << " Mops/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 10000000;
+    int keys = argc > 2 ? atoi(argv[2]) : 1000000;
+
+    //zipf(0.99)的累积分布，按二分查找抽样
+    double *cdf = new double[keys];
+    double sum = 0;
+    for (int i = 0; i < keys; ++i) {
+        sum += 1.0 / std::pow(i + 1.0, 0.99);
+        cdf[i] = sum;
+    }
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    int *trace = new int[ops];
+    int scan_key = keys;
+    for (int i = 0; i < ops; ++i) {
+        //每10万次访问里有2万次是扫描，扫描的键都是没出现过的
+        if (i % 100000 < 20000)trace[i] = scan_key++;
+        else trace[i] = (int) (std::lower_bound(cdf, cdf + keys, uniform(gen)) - cdf);
+    }
+
+    for (size_t capacity = keys / 100; capacity <= (size_t) keys / 10; capacity *= 10) {
+        run<sjtu::lru_cache<int, int>>("lru ", capacity, trace, ops);
+        run<sjtu::slru_cache<int, int>>("slru", capacity, trace, ops);
+    }
+    delete[]cdf;
+    delete[]trace;
+    return 0;
+}
@@ -0,0 +1,40 @@
+//反复clear和拷贝：./bench_clear_copy [rounds]
+//small: 表很大（先reserve过）但每次只放3个元素再clear
+//copy: 拷贝一个有10万个元素的表再析构
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "linked_hashmap.hpp"
+
+template<class T>
+void run(const char *name, const T &value, int rounds) {
+    sjtu::linked_hashmap<int, T> small;
+    small.reserve(41519);
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < 3; ++i)small[r * 3 + i] = value;
+        small.clear();
+    }
+    auto middle = std::chrono::steady_clock::now();
+
+    sjtu::linked_hashmap<int, T> big;
+    for (int i = 0; i < 100000; ++i)big[i * 7] = value;
+    size_t total = 0;
+    for (int r = 0; r < rounds / 1000; ++r) {
+        sjtu::linked_hashmap<int, T> copy(big);
+        total += copy.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> clear_cost = middle - start, copy_cost = end - middle;
+    std::cout << name << ": small fill+clear " << clear_cost.count() / rounds * 1e9 << " ns/round, copy+destroy 100k "
+              << copy_cost.count() / (rounds / 1000) * 1e3 << " ms/round (" << total << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 100000;
+    run<int>("int", 1, rounds);
+    run<std::string>("string", std::string(32, 'x'), rounds);
+    return 0;
+}
@@ -0,0 +1,76 @@
+//多线程读写混合的吞吐量：全局锁+linked_hashmap 对比 concurrent_linked_hashmap
+//./bench_concurrent [读的百分比]
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include "concurrent_linked_hashmap.hpp"
+
+const int ops_per_thread = 1000000;
+const int key_range = 1 << 20;
+
+struct locked_map {
+    std::mutex lock;
+    sjtu::linked_hashmap<int, int> map;
+
+    bool find(int key, int &value) {
+        std::lock_guard<std::mutex> guard(lock);
+        sjtu::linked_hashmap<int, int>::iterator it = map.find(key);
+        if (it == map.end())return false;
+        value = it->second;
+        return true;
+    }
+
+    void assign(int key, int value) {
+        std::lock_guard<std::mutex> guard(lock);
+        map[key] = value;
+    }
+
+    bool erase(int key) {
+        std::lock_guard<std::mutex> guard(lock);
+        sjtu::linked_hashmap<int, int>::iterator it = map.find(key);
+        if (it == map.end())return false;
+        map.erase(it);
+        return true;
+    }
+};
+
+template<class Map>
+double run(Map &m, int threads, int read_percent) {
+    for (int i = 0; i < key_range; i += 2)m.assign(i, i);
+    auto start = std::chrono::steady_clock::now();
+    std::thread *workers = new std::thread[threads];
+    for (int t = 0; t < threads; ++t) {
+        workers[t] = std::thread([&m, t, read_percent]() {
+            unsigned int seed = t * 7919 + 1;
+            int value;
+            for (int i = 0; i < ops_per_thread; ++i) {
+                seed = seed * 1103515245 + 12345;
+                int key = (int) (seed >> 8) % key_range;
+                int op = (int) ((seed >> 4) % 100);
+                if (op < read_percent)m.find(key, value);
+                else if (op & 1)m.assign(key, i);
+                else m.erase(key);
+            }
+        });
+    }
+    for (int t = 0; t < threads; ++t)workers[t].join();
+    delete[]workers;
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    return ops_per_thread * (double) threads / cost.count() / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+    int read_percent = argc > 1 ? atoi(argv[1]) : 90;
+    std::cout << read_percent << "% reads" << std::endl;
+    std::cout << "threads\tglobal_lock\tsharded\t(Mops/s)" << std::endl;
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        locked_map global;
+        sjtu::concurrent_linked_hashmap<int, int> sharded(4 * threads);
+        double a = run(global, threads, read_percent);
+        double b = run(sharded, threads, read_percent);
+        std::cout << threads << "\t" << a << "\t" << b << std::endl;
+    }
+    return 0;
+}
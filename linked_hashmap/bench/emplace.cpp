@@ -0,0 +1,33 @@
+//值是长字符串时各种插入方式的开销：./bench_emplace [n] [len]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "linked_hashmap.hpp"
+
+typedef sjtu::linked_hashmap<int, std::string> map_type;
+
+template<class F>
+void run(const char *name, int n, F f) {
+    map_type map;
+    map.reserve(n);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)f(map, i);
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << n / cost.count() / 1e6 << " Mops/s (size " << map.size() << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int len = argc > 2 ? atoi(argv[2]) : 64;
+    std::string value(len, 'v');
+
+    run("operator[] =     ", n, [&](map_type &map, int i) { map[i] = value; });
+    run("insert(const &)  ", n, [&](map_type &map, int i) { map.insert(map_type::value_type(i, value)); });
+    run("insert(&&)       ", n, [&](map_type &map, int i) {
+        map.insert(map_type::value_type(i, std::string(len, 'v')));
+    });
+    run("try_emplace      ", n, [&](map_type &map, int i) { map.try_emplace(i, len, 'v'); });
+    run("insert_or_assign ", n, [&](map_type &map, int i) { map.insert_or_assign(i, std::string(len, 'v')); });
+    return 0;
+}
@@ -0,0 +1,45 @@
+//TTL过期：不停地插入新键，同时删掉最老的一批：./bench_expire [n] [batch]
+//键是64字节的字符串，删除时要不要重新算哈希差别很明显
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "linked_hashmap.hpp"
+
+typedef sjtu::linked_hashmap<std::string, int> map_type;
+
+template<class F>
+void run(const char *name, std::string *keys, int n, int batch, F expire) {
+    map_type map;
+    for (int i = 0; i < n; ++i)map[keys[i]] = i;
+    //每轮先删掉最老的batch个，再插入batch个新的，表的大小保持不变，只计删除的时间
+    std::chrono::duration<double> cost(0);
+    for (int round = 0; round < n / batch; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        expire(map, batch);
+        cost += std::chrono::steady_clock::now() - start;
+        for (int i = 0; i < batch; ++i)map[keys[(round * batch + i) % n]] = i;
+    }
+    std::cout << name << ": " << n / cost.count() / 1e6 << " M expired/s (size " << map.size() << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int batch = argc > 2 ? atoi(argv[2]) : 1000;
+    std::string *keys = new std::string[n];
+    for (int i = 0; i < n; ++i)keys[i] = std::string(56, 'k') + std::to_string(i + 10000000);
+
+    run("erase(begin())", keys, n, batch, [](map_type &map, int k) {
+        for (int i = 0; i < k; ++i)map.erase(map.begin());
+    });
+    run("pop_front     ", keys, n, batch, [](map_type &map, int k) {
+        for (int i = 0; i < k; ++i)map.pop_front();
+    });
+    run("erase(range)  ", keys, n, batch, [](map_type &map, int k) {
+        map_type::iterator last = map.begin();
+        for (int i = 0; i < k; ++i)++last;
+        map.erase(map.begin(), last);
+    });
+    delete[]keys;
+    return 0;
+}
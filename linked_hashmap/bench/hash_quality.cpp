@@ -0,0 +1,94 @@
+//不同的键分布下，各种哈希函数和桶下标算法的插入+查找速度：./bench_hash_quality [n]
+//整数键：连续、步长1024、只有高32位在变、随机、桶数的倍数；字符串键：短的和长的
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "linked_hashmap.hpp"
+
+//std::hash的整数版本就是原值，这里故意标成avalanching，看只用低位会怎样
+struct identity_mask : std::hash<long long> {
+    typedef void is_avalanching;
+};
+
+//同样是原值，但用fibonacci取高位
+struct identity_fibonacci : std::hash<long long> {
+};
+
+namespace sjtu {
+    template<>
+    struct hash_reduction<identity_fibonacci> {
+        static const bucket_reduction value = power_of_two_fibonacci;
+    };
+}
+
+template<class Key, class Hash>
+double run(const std::vector<Key> &keys) {
+    sjtu::linked_hashmap<Key, int, Hash> map;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i)map[keys[i]] = (int) i;
+    long long hits = 0;
+    for (size_t i = 0; i < keys.size(); ++i)hits += map.count(keys[i]);
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    if (hits != (long long) map.size())std::cout << "wrong result" << std::endl;
+    return 2.0 * keys.size() / cost.count() / 1e6;
+}
+
+//取模时n个元素最后的桶数，键都取它的倍数就全落在一个桶里
+long long final_buckets(int n) {
+    sjtu::linked_hashmap<long long, int> probe;
+    probe.reserve(n);
+    return (long long) probe.bucket_count();
+}
+
+std::vector<long long> make_keys(int pattern, int n) {
+    std::vector<long long> keys;
+    unsigned long long seed = 12345;
+    long long buckets = final_buckets(n);
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        if (pattern == 0)keys.push_back(i);
+        else if (pattern == 1)keys.push_back((long long) i * 1024);
+        else if (pattern == 2)keys.push_back((long long) i << 32);
+        else if (pattern == 3)keys.push_back((long long) (seed >> 1));
+        else keys.push_back(i * buckets);
+    }
+    return keys;
+}
+
+//会退化成一条链的组合只跑n/100个键，不然跑不完
+template<class Hash>
+void cell(int pattern, int n, bool degenerate) {
+    if (degenerate)std::cout << run<long long, Hash>(make_keys(pattern, n / 100)) << " (n/100)\t";
+    else std::cout << run<long long, Hash>(make_keys(pattern, n)) << "\t\t";
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    const char *names[5] = {"sequential     ", "stride 1024    ", "high bits      ", "random         ",
+                            "bucket multiple"};
+    std::cout << "integer keys, Mops/s\tstd::hash(prime)\tint_hash(mask)\tidentity(fibonacci)\tidentity(mask)"
+              << std::endl;
+    for (int p = 0; p < 5; ++p) {
+        std::cout << names[p] << "\t\t";
+        cell<std::hash<long long>>(p, n, p == 4);
+        cell<sjtu::int_hash>(p, n, false);
+        cell<identity_fibonacci>(p, n, false);
+        cell<identity_mask>(p, n, p == 1 || p == 2);
+        std::cout << std::endl;
+    }
+
+    std::cout << "string keys, Mops/s\tstd::hash(prime)\twyhash(mask)\txxh3_hash(mask)" << std::endl;
+    for (int len : {8, 24, 200}) {
+        std::vector<std::string> keys;
+        for (int i = 0; i < n; ++i) {
+            std::string key = std::to_string(i);
+            keys.push_back(std::string(len > (int) key.size() ? len - key.size() : 0, 'k') + key);
+        }
+        std::cout << "length " << len << "\t\t" << run<std::string, std::hash<std::string>>(keys) << "\t\t"
+                  << run<std::string, sjtu::wyhash>(keys) << "\t\t"
+                  << run<std::string, sjtu::xxh3_hash>(keys) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+//逐个插入n个键，统计单次插入的耗时分布，看扩容时的停顿：./bench_latency [n]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include "linked_hashmap.hpp"
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 4000000;
+    sjtu::linked_hashmap<int, int> map;
+    double *cost = new double[n];
+    for (int i = 0; i < n; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        map[i * 7 + 1] = i;
+        std::chrono::duration<double, std::micro> d = std::chrono::steady_clock::now() - start;
+        cost[i] = d.count();
+    }
+    std::sort(cost, cost + n);
+    std::cout << "n " << n << ", buckets " << map.bucket_count() << std::endl;
+    std::cout << "p50 " << cost[n / 2] << "us, p99 " << cost[(long long) n * 99 / 100] << "us, p99.99 "
+              << cost[(long long) n * 9999 / 10000] << "us, max " << cost[n - 1] << "us" << std::endl;
+    delete[]cost;
+    return 0;
+}
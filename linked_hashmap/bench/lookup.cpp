@@ -0,0 +1,44 @@
+//插入n个int键，再查找n次（一半命中一半不命中）：./bench_lookup [n]
+//定义 OPEN_ADDRESSING 时用 robin_hood.hpp，否则用 linked_hashmap.hpp
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#ifdef OPEN_ADDRESSING
+#include "robin_hood.hpp"
+
+template<class Key, class T>
+using map_type = sjtu::robin_hood_hashmap<Key, T>;
+#else
+#include "linked_hashmap.hpp"
+
+template<class Key, class T>
+using map_type = sjtu::linked_hashmap<Key, T>;
+#endif
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    map_type<int, int> map;
+    unsigned int seed = 12345;
+    int *keys = new int[n];
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        keys[i] = (int) (seed & 0x7fffffff);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)map[keys[i]] = i;
+    auto middle = std::chrono::steady_clock::now();
+    long long hits = 0;
+    for (int i = 0; i < n; ++i) {
+        hits += map.count(keys[i]);
+        hits += map.count(-keys[i] - 1);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> insert_cost = middle - start, lookup_cost = end - middle;
+    std::cout << "n " << n << ", size " << map.size() << ", hits " << hits << std::endl;
+    std::cout << "insert " << n / insert_cost.count() / 1e6 << " Mops/s, lookup "
+              << 2.0 * n / lookup_cost.count() / 1e6 << " Mops/s" << std::endl;
+    delete[]keys;
+    return 0;
+}
@@ -0,0 +1,57 @@
+//读多写少：若干读线程不停地find，一个写线程不停地改值/删除/插入
+//对比 concurrent_linked_hashmap（读写锁）和 rcu_linked_hashmap（读不加锁）的读吞吐
+#include <iostream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include "concurrent_linked_hashmap.hpp"
+#include "rcu_linked_hashmap.hpp"
+
+const int reads_per_thread = 2000000;
+const int key_range = 1 << 16;
+
+template<class Map>
+double run(Map &m, int readers) {
+    for (int i = 0; i < key_range; ++i)m.assign(i, i);
+    std::atomic<bool> done(false);
+    std::thread writer([&m, &done]() {
+        unsigned int seed = 17;
+        while (!done.load()) {
+            seed = seed * 1103515245 + 12345;
+            int key = (int) (seed >> 8) % key_range;
+            if (seed & 1)m.assign(key, (int) seed);
+            else m.erase(key);
+            std::this_thread::yield();
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    std::thread *workers = new std::thread[readers];
+    for (int t = 0; t < readers; ++t) {
+        workers[t] = std::thread([&m, t]() {
+            unsigned int seed = t * 7919 + 1;
+            int value;
+            for (int i = 0; i < reads_per_thread; ++i) {
+                seed = seed * 1103515245 + 12345;
+                m.find((int) (seed >> 8) % key_range, value);
+            }
+        });
+    }
+    for (int t = 0; t < readers; ++t)workers[t].join();
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    done.store(true);
+    writer.join();
+    delete[]workers;
+    return reads_per_thread * (double) readers / cost.count() / 1e6;
+}
+
+int main() {
+    std::cout << "readers\trw_lock\trcu\t(M reads/s, one writer running)" << std::endl;
+    for (int readers = 1; readers <= 16; readers *= 2) {
+        sjtu::concurrent_linked_hashmap<int, int> locked(16);
+        sjtu::rcu_linked_hashmap<int, int> rcu;
+        double a = run(locked, readers);
+        double b = run(rcu, readers);
+        std::cout << readers << "\t" << a << "\t" << b << std::endl;
+    }
+    return 0;
+}
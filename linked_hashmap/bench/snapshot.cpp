@@ -0,0 +1,65 @@
+//重启时重建表：文本导出再逐个插入 / 二进制load / 直接mmap：./bench_snapshot [n] [dir]
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "linked_hashmap.hpp"
+#include "linked_hashmap_image.hpp"
+
+typedef sjtu::linked_hashmap<int, long long> map_type;
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    return cost.count();
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 5000000;
+    std::string dir = argc > 2 ? argv[2] : "/tmp";
+    std::string text_path = dir + "/bench_snapshot.txt", binary_path = dir + "/bench_snapshot.bin";
+
+    map_type map;
+    for (int i = 0; i < n; ++i)map[(int) ((unsigned int) i * 2654435761u)] = i;
+
+    FILE *text = fopen(text_path.c_str(), "w");
+    for (map_type::iterator it = map.begin(); it != map.end(); ++it)fprintf(text, "%d %lld\n", it->first, it->second);
+    fclose(text);
+    auto start = std::chrono::steady_clock::now();
+    FILE *binary = fopen(binary_path.c_str(), "wb");
+    map.save(binary);
+    fclose(binary);
+    std::cout << "save " << seconds_since(start) << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    {
+        map_type rebuilt;
+        text = fopen(text_path.c_str(), "r");
+        int key;
+        long long value;
+        while (fscanf(text, "%d %lld", &key, &value) == 2)rebuilt[key] = value;
+        fclose(text);
+        std::cout << "text + insert " << seconds_since(start) << " s (size " << rebuilt.size() << ")" << std::endl;
+    }
+
+    start = std::chrono::steady_clock::now();
+    {
+        map_type loaded;
+        binary = fopen(binary_path.c_str(), "rb");
+        loaded.load(binary);
+        fclose(binary);
+        std::cout << "load " << seconds_since(start) << " s (size " << loaded.size() << ")" << std::endl;
+    }
+
+    start = std::chrono::steady_clock::now();
+    sjtu::linked_hashmap_image<int, long long> image(binary_path.c_str());
+    double open_cost = seconds_since(start);
+    long long sum = 0;
+    for (int i = 0; i < n; ++i)sum += *image.find((int) ((unsigned int) i * 2654435761u));
+    std::cout << "mmap open " << open_cost << " s, then " << n << " lookups " << seconds_since(start) - open_cost
+              << " s (checksum " << sum << ")" << std::endl;
+
+    remove(text_path.c_str());
+    remove(binary_path.c_str());
+    return 0;
+}
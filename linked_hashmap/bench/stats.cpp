@@ -0,0 +1,44 @@
+//插入n个键再各查一次，打印linked_hashmap_stats：./bench_stats [n]
+//定义 SJTU_LINKEDHASHMAP_STATS 时带统计，否则只计时，两个一比就是统计的开销
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "linked_hashmap.hpp"
+
+//键都是1024的倍数，只用低位的时候挤在少数几个桶里
+struct weak_hash : std::hash<long long> {
+    typedef void is_avalanching;
+};
+
+template<class Hash>
+void run(const char *name, int n) {
+    sjtu::linked_hashmap<long long, int, Hash> map;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)map[(long long) i * 1024] = i;
+    long long hits = 0;
+    for (int i = 0; i < n; ++i)hits += map.count((long long) i * 1024);
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": n " << n << ", hits " << hits << ", " << 2.0 * n / cost.count() / 1e6 << " Mops/s"
+              << std::endl;
+#ifdef SJTU_LINKEDHASHMAP_STATS
+    sjtu::linked_hashmap_stats s = map.stats();
+    std::cout << "  buckets " << s.bucket_count << ", load " << s.load_factor << ", max chain " << s.max_chain
+              << ", probes/lookup " << s.average_probes << std::endl;
+    std::cout << "  rehashes " << s.rehashes << " (" << s.rehash_seconds * 1e3 << " ms), bytes/entry "
+              << s.bytes_per_entry << std::endl;
+    std::cout << "  chains:";
+    for (int i = 0; i < sjtu::linked_hashmap_stats::histogram_size; ++i)
+        if (s.chain_histogram[i] != 0)
+            std::cout << " " << i << (i == sjtu::linked_hashmap_stats::histogram_size - 1 ? "+" : "") << "x"
+                      << s.chain_histogram[i];
+    std::cout << std::endl;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    run<std::hash<long long>>("std::hash", n);
+    run<sjtu::int_hash>("int_hash", n);
+    run<weak_hash>("weak_hash", n / 100);
+    return 0;
+}
@@ -0,0 +1,55 @@
+//长字符串键：键都有一段很长的相同前缀，比较两个键要扫过整个前缀：./bench_string_keys [n] [len]
+//max_load_factor调大以后链变长，看走链时比了多少次字符串
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "linked_hashmap.hpp"
+
+long long compares = 0;
+
+struct Equal {
+    bool operator()(const std::string &a, const std::string &b) const {
+        ++compares;
+        return a == b;
+    }
+};
+
+void run(float max_load, std::string *keys, std::string *misses, int n) {
+    sjtu::linked_hashmap<std::string, int, std::hash<std::string>, Equal> map;
+    map.max_load_factor(max_load);
+    compares = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)map[keys[i]] = i;
+    auto middle = std::chrono::steady_clock::now();
+    long long insert_compares = compares;
+    compares = 0;
+    long long hits = 0;
+    for (int i = 0; i < n; ++i) {
+        hits += map.count(keys[i]);
+        hits += map.count(misses[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> insert_cost = middle - start, lookup_cost = end - middle;
+    std::cout << "max_load " << max_load << ": hits " << hits << ", insert " << n / insert_cost.count() / 1e6 << " Mops/s ("
+              << (double) insert_compares / n << " compares/op), lookup "
+              << 2.0 * n / lookup_cost.count() / 1e6 << " Mops/s ("
+              << (double) compares / (2.0 * n) << " compares/op)" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int len = argc > 2 ? atoi(argv[2]) : 256;
+    std::string prefix(len, 'x');
+    std::string *keys = new std::string[n], *misses = new std::string[n];
+    for (int i = 0; i < n; ++i) {
+        keys[i] = prefix + std::to_string(i);
+        misses[i] = prefix + std::to_string(i + n);
+    }
+    run(1, keys, misses, n);
+    run(8, keys, misses, n);
+    delete[]keys;
+    delete[]misses;
+    return 0;
+}
@@ -0,0 +1,202 @@
+//多线程共享的linked_hashmap：按键分成若干个shard，每个shard一把读写锁
+#ifndef SJTU_CONCURRENT_LINKEDHASHMAP_HPP
+#define SJTU_CONCURRENT_LINKEDHASHMAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include "linked_hashmap.hpp"
+
+namespace sjtu {
+
+/**
+ * a hash map shared by several threads.
+ * keys are spread over a number of linked_hashmaps (shards) by their hash, each guarded by its own
+ * reader-writer lock, so lookups in a shard run in parallel and writers only block their own shard.
+ *
+ * every element carries a global sequence number taken when it is inserted,
+ * for_each() visits shard by shard, for_each_ordered() merges the shards back into insertion order.
+ */
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class concurrent_linked_hashmap {
+    private:
+        struct entry {
+            T value;
+            unsigned long long seq;
+        };
+
+        typedef linked_hashmap<Key, entry, Hash, Equal> map_type;
+
+        struct shard {
+            mutable std::shared_timed_mutex lock;
+            map_type map;
+            char padding[64];//不同的shard不要落在同一条cache line上
+        };
+
+        shard *shards;
+        int shard_count;
+        std::atomic<unsigned long long> next_seq;
+        Hash hash;
+
+        //shard里的linked_hashmap用哈希值模素数，这里先把哈希值打散再选shard，两边才不相关
+        shard &shard_of(size_t h) const {
+            unsigned long long x = h;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            return shards[x % shard_count];
+        }
+
+    public:
+        explicit concurrent_linked_hashmap(int shards_ = 16) {
+            shard_count = shards_ < 1 ? 1 : shards_;
+            shards = new shard[shard_count];
+            next_seq = 0;
+        }
+
+        concurrent_linked_hashmap(const concurrent_linked_hashmap &other) = delete;
+
+        concurrent_linked_hashmap &operator=(const concurrent_linked_hashmap &other) = delete;
+
+        ~concurrent_linked_hashmap() {
+            delete[]shards;
+        }
+
+        /**
+         * insert key if it is not there yet, the key is hashed once for both the shard and the lookup.
+         * return true if it was inserted, false if the key already existed (its value is left alone).
+         */
+        bool insert(const Key &key, const T &value) {
+            size_t h = hash.operator()(key);
+            shard &s = shard_of(h);
+            std::unique_lock<std::shared_timed_mutex> guard(s.lock);
+            //选shard的哈希值接着在shard里用，键只算一次哈希、只走一遍链
+            pair<typename map_type::iterator, bool> result = s.map.try_emplace_hashed(h, key, entry{value, 0});
+            if (!result.second)return false;
+            result.first->second.seq = next_seq++;
+            return true;
+        }
+
+        /**
+         * insert key, or overwrite its value if it exists. the insertion order of an existing key does not change.
+         */
+        void assign(const Key &key, const T &value) {
+            size_t h = hash.operator()(key);
+            shard &s = shard_of(h);
+            std::unique_lock<std::shared_timed_mutex> guard(s.lock);
+            pair<typename map_type::iterator, bool> result = s.map.try_emplace_hashed(h, key, entry{value, 0});
+            if (result.second)result.first->second.seq = next_seq++;
+            else result.first->second.value = value;
+        }
+
+        /**
+         * copy the value of key into value.
+         * return false if there is no such key.
+         */
+        bool find(const Key &key, T &value) const {
+            size_t h = hash.operator()(key);
+            const shard &s = shard_of(h);
+            std::shared_lock<std::shared_timed_mutex> guard(s.lock);
+            //只能用const的find，非const的find会顺手搬rehash的桶，不能和别的读者并行
+            const map_type &map = s.map;
+            typename map_type::const_iterator it = map.find(key, h);
+            if (it == map.cend())return false;
+            value = it->second.value;
+            return true;
+        }
+
+        bool contains(const Key &key) const {
+            size_t h = hash.operator()(key);
+            const shard &s = shard_of(h);
+            std::shared_lock<std::shared_timed_mutex> guard(s.lock);
+            const map_type &map = s.map;
+            return map.find(key, h) != map.cend();
+        }
+
+        /**
+         * return true if key was there and has been erased.
+         */
+        bool erase(const Key &key) {
+            size_t h = hash.operator()(key);
+            shard &s = shard_of(h);
+            std::unique_lock<std::shared_timed_mutex> guard(s.lock);
+            typename map_type::iterator it = s.map.find(key, h);
+            if (it == s.map.end())return false;
+            s.map.erase(it);
+            return true;
+        }
+
+        /**
+         * the number of elements, the shards are counted one after another,
+         *   so it is only exact when no one is writing.
+         */
+        size_t size() const {
+            size_t total = 0;
+            for (int i = 0; i < shard_count; ++i) {
+                std::shared_lock<std::shared_timed_mutex> guard(shards[i].lock);
+                total += shards[i].map.size();
+            }
+            return total;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        void clear() {
+            for (int i = 0; i < shard_count; ++i) {
+                std::unique_lock<std::shared_timed_mutex> guard(shards[i].lock);
+                shards[i].map.clear();
+            }
+        }
+
+        /**
+         * call f(key, value) on every element, shard by shard (in insertion order within a shard).
+         * each shard is read-locked while it is visited, f must not write to this map.
+         */
+        template<class F>
+        void for_each(F f) const {
+            for (int i = 0; i < shard_count; ++i) {
+                std::shared_lock<std::shared_timed_mutex> guard(shards[i].lock);
+                const map_type &map = shards[i].map;
+                for (typename map_type::const_iterator it = map.cbegin(); it != map.cend(); ++it)
+                    f(it->first, it->second.value);
+            }
+        }
+
+        /**
+         * call f(key, value) on every element in global insertion order.
+         * every shard is read-locked for the whole walk, so this is a consistent snapshot;
+         *   f must neither write to this map nor throw.
+         */
+        template<class F>
+        void for_each_ordered(F f) const {
+            for (int i = 0; i < shard_count; ++i)shards[i].lock.lock_shared();
+            //每个shard内部已经按序号递增，每次从各个shard的当前元素里挑序号最小的
+            typename map_type::const_iterator *cur = new typename map_type::const_iterator[shard_count];
+            for (int i = 0; i < shard_count; ++i)cur[i] = shards[i].map.cbegin();
+            while (true) {
+                int best = -1;
+                for (int i = 0; i < shard_count; ++i) {
+                    if (cur[i] == shards[i].map.cend())continue;
+                    if (best == -1 || cur[i]->second.seq < cur[best]->second.seq)best = i;
+                }
+                if (best == -1)break;
+                f(cur[best]->first, cur[best]->second.value);
+                ++cur[best];
+            }
+            delete[]cur;
+            for (int i = 0; i < shard_count; ++i)shards[i].lock.unlock_shared();
+        }
+    };
+
+}
+
+#endif
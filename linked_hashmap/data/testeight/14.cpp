@@ -0,0 +1,130 @@
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+#include <utility>
+
+//记录构造、拷贝、移动的次数，看元素是不是只在节点里造了一次
+class Tracked {
+public:
+	static int constructed, copied, moved, alive;
+	std::string val;
+
+	Tracked() : val("default") { ++constructed; ++alive; }
+	Tracked(const std::string &v) : val(v) { ++constructed; ++alive; }
+	Tracked(const char *a, int n) : val(std::string(a) + std::to_string(n)) { ++constructed; ++alive; }
+	Tracked(const Tracked &rhs) : val(rhs.val) { ++copied; ++alive; }
+	Tracked(Tracked &&rhs) : val(std::move(rhs.val)) { rhs.val = "moved-from"; ++moved; ++alive; }
+	Tracked &operator=(const Tracked &rhs) { val = rhs.val; ++copied; return *this; }
+	Tracked &operator=(Tracked &&rhs) { val = std::move(rhs.val); rhs.val = "moved-from"; ++moved; return *this; }
+	~Tracked() { --alive; }
+};
+
+int Tracked::constructed = 0, Tracked::copied = 0, Tracked::moved = 0, Tracked::alive = 0;
+
+void reset() {
+	Tracked::constructed = Tracked::copied = Tracked::moved = 0;
+}
+
+void report(const char *what) {
+	std::cout << what << ": constructed " << Tracked::constructed << " copied " << Tracked::copied
+	          << " moved " << Tracked::moved << std::endl;
+	reset();
+}
+
+template<class Map>
+void print(const Map &map) {
+	for (auto it = map.cbegin(); it != map.cend(); ++it) std::cout << it->first << "=" << it->second.val << " ";
+	std::cout << std::endl;
+}
+
+void test_emplace() {
+	sjtu::linked_hashmap<int, Tracked> map;
+	reset();
+	auto r = map.emplace(std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("one", 1));
+	std::cout << "emplace new " << r.second << " " << r.first->second.val << std::endl;
+	report("piecewise emplace");
+	auto r1 = map.emplace(1, Tracked("again"));
+	std::cout << "emplace existing " << r1.second << " " << r1.first->second.val << std::endl;
+	report("emplace existing");
+	auto r2 = map.emplace(2, Tracked("two"));
+	std::cout << "emplace pair args " << r2.second << " " << r2.first->second.val << std::endl;
+	report("emplace pair args");
+	print(map);
+}
+
+void test_try_emplace() {
+	sjtu::linked_hashmap<int, Tracked> map;
+	map.try_emplace(5, "five", 5);
+	map.try_emplace(3);
+	reset();
+	Tracked keep("kept");
+	reset();
+	auto r = map.try_emplace(5, std::move(keep));
+	std::cout << "try_emplace existing " << r.second << " " << r.first->second.val << " arg " << keep.val << std::endl;
+	report("try_emplace existing");
+	auto r3 = map.try_emplace(7, std::move(keep));
+	std::cout << "try_emplace new " << r3.second << " " << r3.first->second.val << " arg " << keep.val << std::endl;
+	report("try_emplace new");
+	print(map);
+}
+
+void test_insert_or_assign() {
+	sjtu::linked_hashmap<std::string, Tracked> map;
+	for (int i = 0; i < 5; ++i) map.insert_or_assign(std::to_string(i), Tracked("v" + std::to_string(i)));
+	reset();
+	auto r = map.insert_or_assign("2", Tracked("changed"));
+	std::cout << "assign existing " << r.second << " " << r.first->second.val << std::endl;
+	report("assign existing");
+	std::string key = "9";
+	auto r4 = map.insert_or_assign(std::move(key), Tracked("nine"));
+	std::cout << "assign new " << r4.second << " " << r4.first->second.val << std::endl;
+	report("assign new");
+	//已有的键赋值以后插入顺序不变
+	print(map);
+}
+
+void test_move_insert() {
+	sjtu::linked_hashmap<std::string, Tracked> map;
+	reset();
+	sjtu::pair<const std::string, Tracked> v("a", Tracked("alpha"));
+	reset();
+	auto r = map.insert(std::move(v));
+	std::cout << "move insert " << r.second << " " << r.first->second.val << std::endl;
+	report("move insert");
+	auto r5 = map.insert(sjtu::pair<const std::string, Tracked>("a", Tracked("other")));
+	std::cout << "move insert existing " << r5.second << " " << r5.first->second.val << std::endl;
+	report("move insert existing");
+	std::string key = "b";
+	map[std::move(key)].val = "beta";
+	report("operator[] rvalue key");
+	print(map);
+}
+
+void test_many() {
+	sjtu::linked_hashmap<int, Tracked> map;
+	for (int i = 0; i < 100000; ++i) {
+		if (i % 3 == 0) map.emplace(i, Tracked("e"));
+		else if (i % 3 == 1) map.try_emplace(i, "t", i);
+		else map.insert_or_assign(i, Tracked("a"));
+	}
+	for (int i = 0; i < 100000; i += 2) map.insert_or_assign(i, Tracked("b"));
+	for (int i = 0; i < 100000; i += 5) map.try_emplace(i, "never", 0);
+	long long sum = 0;
+	int expect = 0;
+	bool ordered = true;
+	for (auto it = map.cbegin(); it != map.cend(); ++it, ++expect) {
+		if (it->first != expect) ordered = false;
+		sum += it->second.val.size() * (long long) it->first;
+	}
+	std::cout << "many: size " << map.size() << " ordered " << ordered << " checksum " << sum << std::endl;
+}
+
+int main() {
+	test_emplace();
+	test_try_emplace();
+	test_insert_or_assign();
+	test_move_insert();
+	test_many();
+	std::cout << "alive " << Tracked::alive << std::endl;
+	return 0;
+}
@@ -0,0 +1,82 @@
+#define SJTU_LINKEDHASHMAP_STATS
+#include "linked_hashmap.hpp"
+#include <iostream>
+
+//stats()的计数：std::hash<int>就是键本身，13个桶时0、13、26、39落在同一个桶里，每次查找比较几次都能算出来
+//新节点挂在链尾，所以第k个插进同一个桶的键要先比较前面的k-1个
+typedef sjtu::linked_hashmap<int, int> Map;
+
+const size_t table_bytes = sizeof(Map);
+
+void print(const char *name, const Map &map) {
+	sjtu::linked_hashmap_stats s = map.stats();
+	size_t buckets = 0, elements = 0;
+	for (int i = 0; i < sjtu::linked_hashmap_stats::histogram_size; ++i) {
+		buckets += s.chain_histogram[i];
+		elements += s.chain_histogram[i] * i;
+	}
+	std::cout << name << ": size " << s.size << " buckets " << s.bucket_count
+	          << " histogram " << buckets << '/' << elements << " max_chain " << s.max_chain
+	          << " lookups " << s.lookups << " probes " << s.probes << " average " << s.average_probes
+	          << " rehashes " << s.rehashes << std::endl;
+}
+
+//减掉表本身和桶数组，剩下的是节点所在的块；rehash没搬完的时候不能用
+size_t node_bytes(const Map &map) {
+	sjtu::linked_hashmap_stats s = map.stats();
+	return s.bytes - table_bytes - sizeof(void *) * s.bucket_count;
+}
+
+int main() {
+	Map map;
+	print("empty", map);
+	std::cout << "no nodes yet: " << (node_bytes(map) == 0) << std::endl;
+
+	//插入前的查找：0比较0次，13比较1次，26比较2次
+	map[0] = 0;
+	map[13] = 1;
+	map[26] = 2;
+	print("three in bucket 0", map);
+	sjtu::linked_hashmap_stats s = map.stats();
+	std::cout << "one block: " << (node_bytes(map) >= 16 * sizeof(sjtu::pair<const int, int>)) << std::endl;
+	std::cout << "bytes per entry: " << (s.bytes_per_entry == (double) s.bytes / 3) << std::endl;
+
+	//命中0比较1次、命中26比较3次、没有39比较3次、桶1是空的比较0次、count(13)比较2次
+	const Map &cmap = map;
+	std::cout << (cmap.find(0) != cmap.cend()) << (cmap.find(26) != cmap.cend())
+	          << (cmap.find(39) == cmap.cend()) << (cmap.find(1) == cmap.cend()) << map.count(13) << std::endl;
+	print("after finds", map);
+
+	//已有的键再插一次只查找，不加元素
+	map.insert(sjtu::pair<const int, int>(13, 100));
+	print("insert existing", map);
+
+	size_t before = map.stats().bytes;
+	map.reset_stats();
+	s = map.stats();
+	print("reset", map);
+	std::cout << "rehash_seconds " << s.rehash_seconds << " bytes kept: " << (s.bytes == before) << std::endl;
+
+	//第14个元素让装载因子超过1，换成29个桶；第30个再换成59个桶
+	for (int i = 1; i <= 11; ++i)map[i] = i;
+	print("fourteen", map);
+	for (int i = 100; i < 116; ++i)map[i] = i;
+	print("thirty", map);
+	//旧的29个桶还没搬完，bytes里也算着；已有的键再访问几次把它搬完，正好少29个指针
+	size_t migrating = map.stats().bytes;
+	for (int i = 100; i < 116; ++i)map[i];
+	print("migrated", map);
+	std::cout << "old table freed: " << (migrating - map.stats().bytes == sizeof(void *) * 29) << std::endl;
+
+	//reserve直接重建一次，不是渐进的
+	map.reserve(1000);
+	print("reserve", map);
+	map.reset_stats();
+	print("reset again", map);
+
+	//clear把节点的块都还掉
+	map.clear();
+	std::cout << "cleared: size " << map.size() << " no nodes: " << (node_bytes(map) == 0)
+	          << " bytes per entry " << map.stats().bytes_per_entry << std::endl;
+	return 0;
+}
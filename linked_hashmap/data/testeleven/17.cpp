@@ -0,0 +1,124 @@
+#include "linked_hashmap.hpp"
+#include "robin_hood.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+//两个引擎放在同一个翻译单元里，robin hood 的结果每一步都和链式的 linked_hashmap 对拍
+struct few_buckets {
+	size_t operator()(int x) const {
+		return (size_t) (x & 63);
+	}
+};
+
+template<class Hash>
+bool same_order(sjtu::robin_hood_hashmap<int, int, Hash> &a, sjtu::linked_hashmap<int, int, Hash> &b) {
+	if (a.size() != b.size()) return false;
+	auto it = a.cbegin();
+	for (auto jt = b.cbegin(); jt != b.cend(); ++it, ++jt)
+		if (it == a.cend() || it->first != jt->first || it->second != jt->second) return false;
+	return it == a.cend();
+}
+
+void test_references() {
+	sjtu::robin_hood_hashmap<int, std::string> map;
+	const int kept = 100;
+	std::string *values[kept];
+	const sjtu::pair<const int, std::string> *pairs[kept];
+	for (int i = 0; i < kept; ++i) {
+		map[i] = "value " + std::to_string(i);
+		values[i] = &map[i];
+		pairs[i] = &*map.find(i);
+	}
+	//表和插入顺序数组扩了很多次，元素本身不能搬家
+	for (int i = kept; i < 300000; ++i) map[i] = std::to_string(i);
+	for (int i = kept; i < 300000; i += 2) map.erase(map.find(i));
+	for (int i = 300000; i < 400000; ++i) map.insert(sjtu::pair<const int, std::string>(i, "new"));
+	bool stable = true;
+	for (int i = 0; i < kept; ++i)
+		if (values[i] != &map.at(i) || pairs[i] != &*map.find(i) || *values[i] != "value " + std::to_string(i))
+			stable = false;
+	*values[7] = "written through a reference";
+	std::cout << "references stable " << stable << ", size " << map.size() << ", " << map.at(7) << std::endl;
+}
+
+template<class Hash>
+void test_random(const char *name, int range) {
+	sjtu::robin_hood_hashmap<int, int, Hash> a;
+	sjtu::linked_hashmap<int, int, Hash> b;
+	srand(35);
+	bool same = true;
+	int checks = 0;
+	for (int i = 0; i < 300000; ++i) {
+		int key = rand() % range, op = rand() % 10;
+		if (op < 4) {
+			auto ra = a.insert(sjtu::pair<const int, int>(key, i));
+			auto rb = b.insert(sjtu::pair<const int, int>(key, i));
+			if (ra.second != rb.second || ra.first->second != rb.first->second) same = false;
+		} else if (op < 7) {
+			auto ia = a.find(key);
+			auto ib = b.find(key);
+			if ((ia == a.end()) != (ib == b.end())) same = false;
+			else if (ia != a.end()) {
+				a.erase(ia);
+				b.erase(ib);
+			}
+		} else if (op < 9) {
+			if (a.count(key) != b.count(key)) same = false;
+			else if (a.count(key) && a.at(key) != b.at(key)) same = false;
+		} else {
+			a[key] += i;
+			b[key] += i;
+		}
+		if (i % 10000 == 0) {
+			++checks;
+			if (!same_order(a, b)) same = false;
+		}
+	}
+	bool order = same_order(a, b);
+	//删空再插，空闲entry和空槽都要能复用
+	while (!b.empty()) {
+		a.erase(a.find(b.cbegin()->first));
+		b.erase(b.begin());
+	}
+	for (int i = 0; i < 1000; ++i) a[i] = b[i] = i;
+	std::cout << name << ": same " << same << " order " << order << " checks " << checks << " refilled "
+	          << same_order(a, b) << std::endl;
+}
+
+void test_copy() {
+	sjtu::robin_hood_hashmap<int, int> a;
+	for (int i = 0; i < 5000; ++i) a[i * 31] = i;
+	sjtu::robin_hood_hashmap<int, int> b(a), c;
+	c = a;
+	c = c;
+	a.clear();
+	a[1] = 1;
+	int thrown = 0;
+	try {
+		b.at(-1);
+	} catch (sjtu::index_out_of_bound &) {
+		++thrown;
+	}
+	try {
+		b.erase(c.find(31));
+	} catch (sjtu::exception &) {
+		++thrown;
+	}
+	try {
+		b.erase(b.end());
+	} catch (sjtu::exception &) {
+		++thrown;
+	}
+	std::cout << "copies " << a.size() << " " << b.size() << " " << c.size() << " " << b.at(31 * 4999) << " "
+	          << c.cbegin()->second << " thrown " << thrown << std::endl;
+}
+
+int main() {
+	test_references();
+	test_random<std::hash<int>>("std::hash, dense keys", 1000);
+	test_random<std::hash<int>>("std::hash, sparse keys", 100000);
+	test_random<few_buckets>("64 hash values", 3000);
+	test_copy();
+	return 0;
+}
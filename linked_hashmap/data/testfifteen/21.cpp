@@ -0,0 +1,121 @@
+#include "lru_cache.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+//固定的访问序列，每一步打印命中与否、被淘汰的键
+template<class Cache>
+struct tracer {
+	Cache &cache;
+	std::vector<std::string> universe;
+
+	void report(const std::string &op, const std::vector<bool> &before) {
+		std::cout << op;
+		bool first = true;
+		for (size_t i = 0; i < universe.size(); ++i)
+			if (before[i] && !cache.contains(universe[i])) {
+				std::cout << (first ? " evicts" : "") << " " << universe[i];
+				first = false;
+			}
+		std::cout << std::endl;
+	}
+
+	std::vector<bool> snapshot() {
+		std::vector<bool> in;
+		for (auto &k : universe) in.push_back(cache.contains(k));
+		return in;
+	}
+
+	void put(const std::string &key, int value) {
+		auto before = snapshot();
+		cache.put(key, value);
+		report("put " + key, before);
+	}
+
+	void get(const std::string &key) {
+		auto before = snapshot();
+		int *v = cache.get(key);
+		report("get " + key + (v ? " hit " + std::to_string(*v) : " miss"), before);
+	}
+
+	void cached() {
+		std::cout << "cached:";
+		for (auto &k : universe)
+			if (cache.contains(k)) std::cout << " " << k;
+		std::cout << " (" << cache.size() << "/" << cache.capacity() << ", hits " << cache.hits() << ", misses "
+		          << cache.misses() << ")" << std::endl;
+	}
+};
+
+std::vector<std::string> keys(int n) {
+	std::vector<std::string> k;
+	for (int i = 0; i < n; ++i) k.push_back(std::string(1, (char) ('a' + i)));
+	return k;
+}
+
+void test_lru() {
+	std::cout << "lru, capacity 3" << std::endl;
+	sjtu::lru_cache<std::string, int> cache(3);
+	tracer<sjtu::lru_cache<std::string, int>> t{cache, keys(8)};
+	t.put("a", 1);
+	t.put("b", 2);
+	t.put("c", 3);
+	t.get("a");
+	t.put("d", 4);
+	t.get("b");
+	t.get("c");
+	t.put("e", 5);
+	t.put("d", 40);
+	t.put("f", 6);
+	t.get("d");
+	cache.erase("e");
+	t.cached();
+	t.put("g", 7);
+	t.put("h", 8);
+	t.cached();
+	//contains不改变顺序
+	cache.contains("d");
+	t.put("a", 1);
+	t.cached();
+}
+
+void test_slru() {
+	std::cout << "slru, capacity 5, protected 3" << std::endl;
+	sjtu::slru_cache<std::string, int> cache(5, 0.6f);
+	tracer<sjtu::slru_cache<std::string, int>> t{cache, keys(16)};
+	t.put("a", 1);
+	t.put("b", 2);
+	t.put("c", 3);
+	t.get("b");
+	t.get("c");
+	t.put("d", 4);
+	t.put("e", 5);
+	t.put("f", 6);
+	t.get("e");
+	//保护段满了：f升上去，最久没用的b降回试用段
+	t.get("f");
+	t.cached();
+	//只用一次的键扫过去，只会在试用段里转
+	for (char k = 'g'; k <= 'n'; ++k) t.put(std::string(1, k), k - 'a' + 1);
+	t.cached();
+	t.get("c");
+	t.get("e");
+	t.get("f");
+	t.get("b");
+	t.put("m", 130);
+	t.get("m");
+	t.get("n");
+	t.cached();
+	//m和n升上去的时候把c和e降回了试用段，新键进来先淘汰c
+	t.put("o", 15);
+	t.put("p", 16);
+	t.cached();
+	cache.clear();
+	t.cached();
+}
+
+int main() {
+	test_lru();
+	test_slru();
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include "hash.hpp"
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+#include <functional>
+
+//异构查找：std::string的键直接用const char *查，数一数哈希函数被调用了几次
+int hash_calls = 0;
+
+struct counting_hash {
+	typedef void is_transparent;
+
+	size_t operator()(const std::string &s) const {
+		++hash_calls;
+		return sjtu::xxh3_hash()(s);
+	}
+
+	size_t operator()(const char *s) const {
+		++hash_calls;
+		return sjtu::xxh3_hash()(s);
+	}
+};
+
+typedef sjtu::linked_hashmap<std::string, int, counting_hash, std::equal_to<>> Map;
+
+void print(const Map &map) {
+	std::cout << "size " << map.size() << ":";
+	for (auto it = map.cbegin(); it != map.cend(); ++it) std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl;
+}
+
+void test_transparent() {
+	Map map;
+	const char *words[] = {"apple", "banana", "cherry", "date", "elderberry"};
+	hash_calls = 0;
+	for (int i = 0; i < 5; ++i) map[words[i]] = i;
+	std::cout << "operator[] miss: " << hash_calls << " hashes for 5 inserts" << std::endl;
+	hash_calls = 0;
+	map["banana"] += 10;
+	map["fig"];
+	std::cout << "operator[] hit and miss: " << hash_calls << " hashes" << std::endl;
+	print(map);
+	hash_calls = 0;
+	const Map &c = map;
+	std::cout << "find " << map.find("cherry")->second << " " << (map.find("grape") == map.end()) << " const "
+	          << c.find("date")->second << " " << (c.find("") == c.cend()) << std::endl;
+	std::cout << "count " << map.count("apple") << map.count("apples") << c.count("fig") << std::endl;
+	std::cout << "at " << map.at("elderberry") << " " << c.at("banana") << std::endl;
+	std::cout << "hashes " << hash_calls << std::endl;
+	int thrown = 0;
+	try {
+		map.at("grape");
+	} catch (sjtu::index_out_of_bound &) {
+		++thrown;
+	}
+	try {
+		c.at("grape");
+	} catch (sjtu::index_out_of_bound &) {
+		++thrown;
+	}
+	std::cout << "missing at() thrown " << thrown << ", size " << map.size() << std::endl;
+	//const char *和std::string查到的是同一个元素
+	std::string key = "cherry";
+	std::cout << "same element " << (&map["cherry"] == &map[key]) << " " << (&*map.find("cherry") == &*map.find(key))
+	          << std::endl;
+}
+
+void test_precomputed() {
+	Map a, b;
+	for (int i = 0; i < 1000; ++i) {
+		std::string k = "key" + std::to_string(i);
+		a[k] = i;
+		if (i % 3 == 0) b[k] = -i;
+	}
+	//一个哈希值在两个表里用
+	counting_hash h = a.hash_function();
+	hash_calls = 0;
+	int found_a = 0, found_b = 0;
+	long long sum = 0;
+	for (int i = 0; i < 1200; ++i) {
+		std::string k = "key" + std::to_string(i);
+		size_t hv = h(k);
+		auto ia = a.find(k, hv);
+		auto ib = b.find(k, hv);
+		if (ia != a.end()) ++found_a, sum += ia->second;
+		if (ib != b.end()) ++found_b, sum += ib->second;
+	}
+	std::cout << "precomputed: " << found_a << " " << found_b << " sum " << sum << " hashes " << hash_calls << std::endl;
+	const Map &c = a;
+	hash_calls = 0;
+	size_t hv = h("key7");
+	std::cout << "const " << c.find(std::string("key7"), hv)->second << " transparent " << a.find("key7", hv)->second
+	          << " " << c.find("key7", hv)->second << " missing " << (c.find("key", h("key")) == c.cend())
+	          << " hashes " << hash_calls << std::endl;
+}
+
+void test_many() {
+	//异构插入走的也是渐进式rehash那一套，插多了顺序和查找都要对
+	Map map;
+	char buffer[32];
+	for (int i = 0; i < 50000; ++i) {
+		snprintf(buffer, sizeof(buffer), "%d", i * 7);
+		map[(const char *) buffer] = i;
+	}
+	bool ok = map.size() == 50000;
+	int i = 0;
+	for (auto it = map.cbegin(); it != map.cend(); ++it, ++i)
+		if (it->first != std::to_string(i * 7) || it->second != i) ok = false;
+	for (i = 0; i < 50000; ++i) {
+		snprintf(buffer, sizeof(buffer), "%d", i * 7 + 1);
+		if (map.count((const char *) buffer) != (size_t) ((i * 7 + 1) % 7 == 0)) ok = false;
+	}
+	std::cout << "many " << ok << std::endl;
+}
+
+int main() {
+	test_transparent();
+	test_precomputed();
+	test_many();
+	return 0;
+}
@@ -0,0 +1,180 @@
+#include "linked_hashmap.hpp"
+#include "linked_hashmap_image.hpp"
+#include <iostream>
+#include <cstdio>
+#include <cstddef>
+#include <cmath>
+#include <unistd.h>
+
+//快照文件的格式是对外的约定：这里把一个小表写出来，逐项打印文件内容，格式一变就对不上答案
+typedef sjtu::linked_hashmap<int, double> Map;
+typedef sjtu::linked_hashmap_image_header Header;
+typedef sjtu::linked_hashmap_image_entry<int, double> Entry;
+
+const char *path = "linked_hashmap_snapshot.bin";
+
+bool throws_on_load(const char *file) {
+	FILE *f = fopen(file, "rb");
+	Map map;
+	map[1] = 1;
+	bool thrown = false;
+	try {
+		map.load(f);
+	} catch (sjtu::runtime_error &) {
+		thrown = true;
+	}
+	fclose(f);
+	return thrown && map.empty();
+}
+
+bool throws_on_open(const char *file) {
+	try {
+		sjtu::linked_hashmap_image<int, double> image(file);
+	} catch (sjtu::runtime_error &) {
+		return true;
+	}
+	return false;
+}
+
+void patch(long offset, unsigned int value) {
+	FILE *f = fopen(path, "r+b");
+	fseek(f, offset, SEEK_SET);
+	fwrite(&value, sizeof(value), 1, f);
+	fclose(f);
+}
+
+void test_format() {
+	Map map;
+	for (int i = 0; i < 20; ++i) map[i * 13] = i + 0.5;
+	map.erase(map.find(26));
+	map[5] = -1;
+	FILE *f = fopen(path, "wb");
+	map.save(f);
+	fclose(f);
+
+	f = fopen(path, "rb");
+	Header header;
+	fread(&header, sizeof(header), 1, f);
+	std::cout << "magic " << std::string(header.magic, 8) << " key " << header.key_size << " value "
+	          << header.value_size << " entry " << header.entry_size << " count " << header.count << " buckets "
+	          << header.bucket_count << " max_load " << header.max_load << std::endl;
+	std::cout << "entry layout: first " << offsetof(Entry, first) << " second " << offsetof(Entry, second)
+	          << " hash " << offsetof(Entry, hash_code) << " next " << offsetof(Entry, next) << std::endl;
+	fseek(f, Header::entries_offset, SEEK_SET);
+	for (unsigned long long i = 0; i < header.count; ++i) {
+		Entry e;
+		fread(&e, sizeof(e), 1, f);
+		std::cout << i << ": " << e.first << " " << e.second << " hash " << e.hash_code << " next ";
+		if (e.next == Header::no_entry) std::cout << "-" << std::endl;
+		else std::cout << e.next << std::endl;
+	}
+	std::cout << "buckets:";
+	for (unsigned long long i = 0; i < header.bucket_count; ++i) {
+		unsigned int b;
+		fread(&b, sizeof(b), 1, f);
+		if (b == Header::no_entry) std::cout << " -";
+		else std::cout << " " << b;
+	}
+	std::cout << std::endl;
+	std::cout << "file ends " << (fgetc(f) == EOF) << std::endl;
+	fclose(f);
+}
+
+void test_round_trip() {
+	Map a, b, empty;
+	for (int i = 0; i < 50000; ++i) a[i * 7919 % 100003] = i * 0.25;
+	for (int i = 0; i < 50000; i += 3) a.erase(a.find(i * 7919 % 100003));
+	for (int i = 0; i < 10; ++i) b[-i] = i;
+	//几个快照连着写在一个文件里，按顺序读回来
+	FILE *f = fopen(path, "wb");
+	a.save(f);
+	empty.save(f);
+	b.save(f);
+	fputs("end", f);
+	fclose(f);
+	Map x, y, z;
+	z[3] = 3;
+	f = fopen(path, "rb");
+	x.load(f);
+	y.load(f);
+	z.load(f);
+	char tail[4] = {};
+	fread(tail, 1, 3, f);
+	fclose(f);
+	bool same = x.size() == a.size();
+	auto it = x.cbegin();
+	for (auto jt = a.cbegin(); same && jt != a.cend(); ++it, ++jt)
+		same = it->first == jt->first && it->second == jt->second && x.at(jt->first) == jt->second;
+	std::cout << "round trip " << same << " sizes " << x.size() << " " << y.size() << " " << z.size()
+	          << " tail " << tail << std::endl;
+	x[123456789] = 1;
+	x.erase(x.find(123456789));
+	std::cout << "still usable " << x.size() << " " << x.count(7919) << std::endl;
+
+	f = fopen(path, "wb");
+	a.save(f);
+	fclose(f);
+	sjtu::linked_hashmap_image<int, double> image(path);
+	same = image.size() == a.size();
+	const Entry *e = image.begin();
+	for (auto jt = a.cbegin(); same && jt != a.cend(); ++e, ++jt)
+		same = e->first == jt->first && e->second == jt->second && *image.find(jt->first) == jt->second;
+	std::cout << "image " << same << " " << image.size() << " missing " << image.count(-1) << std::endl;
+}
+
+void test_corrupt() {
+	Map a;
+	for (int i = 0; i < 100; ++i) a[i] = i;
+	FILE *f = fopen(path, "wb");
+	a.save(f);
+	fclose(f);
+	long buckets = Header::entries_offset + 100 * sizeof(Entry);
+	patch(buckets + 4 * sizeof(unsigned int), 100);
+	std::cout << "bad bucket: load " << throws_on_load(path) << " image " << throws_on_open(path) << std::endl;
+
+	f = fopen(path, "wb");
+	a.save(f);
+	fclose(f);
+	patch(Header::entries_offset + 10 * sizeof(Entry) + offsetof(Entry, next), 10);
+	std::cout << "chain loop: image " << throws_on_open(path) << std::endl;
+
+	f = fopen(path, "wb");
+	a.save(f);
+	fclose(f);
+	truncate(path, buckets + 8);
+	std::cout << "truncated: load " << throws_on_load(path) << " image " << throws_on_open(path) << std::endl;
+
+	//max_load是inf的话表永远不会扩容，NaN同理，和max_load_factor()一样拒绝
+	float bad_loads[] = {INFINITY, NAN, 0, -1};
+	int rejected = 0;
+	for (float bad : bad_loads) {
+		f = fopen(path, "wb");
+		a.save(f);
+		fclose(f);
+		f = fopen(path, "r+b");
+		fseek(f, offsetof(Header, max_load), SEEK_SET);
+		fwrite(&bad, sizeof(bad), 1, f);
+		fclose(f);
+		rejected += throws_on_load(path);
+		try {
+			a.max_load_factor(bad);
+		} catch (sjtu::runtime_error &) {
+			++rejected;
+		}
+	}
+	std::cout << "bad max_load: rejected " << rejected << " of 8, still " << a.max_load_factor() << std::endl;
+
+	f = fopen(path, "wb");
+	fputs("not a snapshot at all, just some text that is long enough to hold a header", f);
+	fclose(f);
+	std::cout << "garbage: load " << throws_on_load(path) << " image " << throws_on_open(path) << std::endl;
+	std::cout << "missing: image " << throws_on_open("no_such_snapshot.bin") << std::endl;
+}
+
+int main() {
+	test_format();
+	test_round_trip();
+	test_corrupt();
+	remove(path);
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include "hash.hpp"
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+
+//每个长度、每个位置改一个字节，哈希值都得变
+template<class Hash>
+int unchanged_by_flips(size_t min_len, size_t max_len) {
+	Hash hash;
+	int unchanged = 0;
+	for (size_t len = min_len; len <= max_len; ++len) {
+		std::string key;
+		for (size_t i = 0; i < len; ++i) key += (char) ('a' + (i * 7 + len) % 26);
+		size_t original = hash(key);
+		for (size_t pos = 0; pos < len; ++pos) {
+			std::string flipped = key;
+			flipped[pos] ^= 0x10;
+			if (hash(flipped) == original) ++unchanged;
+		}
+	}
+	return unchanged;
+}
+
+template<class Hash>
+void test_map(const char *name) {
+	sjtu::linked_hashmap<std::string, int, Hash> map;
+	for (int i = 0; i < 20000; ++i) map[std::string(i % 300, 'k') + std::to_string(i)] = i;
+	int found = 0;
+	for (int i = 0; i < 20000; ++i) {
+		std::string key = std::string(i % 300, 'k') + std::to_string(i);
+		if (map.count(key.c_str()) && map.at(key) == i) ++found;
+	}
+	int order = 0;
+	for (auto it = map.cbegin(); it != map.cend(); ++it, ++order)
+		if (it->second != order) break;
+	std::cout << name << " found " << found << " in order " << order << std::endl;
+}
+
+int main() {
+	std::cout << "xxh3 short " << unchanged_by_flips<sjtu::xxh3_hash>(1, 128) << std::endl;
+	std::cout << "xxh3 long " << unchanged_by_flips<sjtu::xxh3_hash>(129, 256) << std::endl;
+	std::cout << "xxh3 very long " << unchanged_by_flips<sjtu::xxh3_hash>(1020, 1100) << std::endl;
+	std::cout << "wyhash short " << unchanged_by_flips<sjtu::wyhash>(1, 128) << std::endl;
+	std::cout << "wyhash long " << unchanged_by_flips<sjtu::wyhash>(129, 256) << std::endl;
+	std::cout << "wyhash very long " << unchanged_by_flips<sjtu::wyhash>(1020, 1100) << std::endl;
+	sjtu::int_hash int_hash;
+	int unchanged = 0;
+	for (int bit = 0; bit < 64; ++bit)
+		if (int_hash(1ull << bit) == int_hash(0ull)) ++unchanged;
+	std::cout << "int_hash " << unchanged << std::endl;
+	test_map<sjtu::wyhash>("wyhash");
+	test_map<sjtu::xxh3_hash>("xxh3_hash");
+	return 0;
+}
@@ -0,0 +1,123 @@
+#include "rcu_linked_hashmap.hpp"
+#include <iostream>
+#include <vector>
+#include <list>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+//数一数值对象还活着几个：删掉的节点攒够128个才一起释放，扩容时整张表复制一份、旧节点马上释放
+std::atomic<int> alive(0), copies(0);
+
+struct Tracked {
+	int key, version;
+
+	Tracked(int k = 0, int v = 0) : key(k), version(v) {
+		++alive;
+	}
+
+	Tracked(const Tracked &other) : key(other.key), version(other.version) {
+		++alive;
+		++copies;
+	}
+
+	~Tracked() {
+		--alive;
+	}
+};
+
+typedef sjtu::rcu_linked_hashmap<int, Tracked> Map;
+
+bool same_order(Map &map, const std::list<int> &ref) {
+	std::vector<int> keys;
+	bool values = true;
+	map.for_each([&](const int &k, const Tracked &v) {
+		keys.push_back(k);
+		if (v.key != k) values = false;
+	});
+	return values && keys == std::vector<int>(ref.begin(), ref.end());
+}
+
+void test_single() {
+	{
+		Map map;
+		std::list<int> ref;
+		copies = 0;
+		for (int i = 0; i < 1000; ++i) {
+			map.insert(i * 37, Tracked(i * 37));
+			ref.push_back(i * 37);
+		}
+		//16个桶起步，扩到1024：每次扩容都复制当时所有的节点
+		std::cout << "inserted " << map.size() << ", alive " << alive << ", copies " << copies << std::endl;
+		for (int i = 0; i < 127; ++i) {
+			map.erase(i * 37);
+			ref.remove(i * 37);
+		}
+		std::cout << "127 erased: size " << map.size() << ", alive " << alive << std::endl;
+		map.erase(127 * 37);
+		ref.remove(127 * 37);
+		std::cout << "128th erase reclaims the batch: size " << map.size() << ", alive " << alive << std::endl;
+		std::cout << "erase missing " << map.erase(1) << " " << map.erase(127 * 37) << std::endl;
+		//assign换一个新节点，旧的也进待释放的链
+		for (int i = 500; i < 510; ++i) map.assign(i * 37, Tracked(i * 37, 1));
+		map.assign(-37, Tracked(-37, 1));
+		ref.push_back(-37);
+		std::cout << "assigned: size " << map.size() << ", alive " << alive << std::endl;
+		//释放之后再查：删掉的查不到，留下的值和版本都对
+		bool ok = true;
+		Tracked v;
+		for (int i = 0; i < 1000; ++i) {
+			bool found = map.find(i * 37, v);
+			if (found != (i >= 128) || map.contains(i * 37) != found) ok = false;
+			if (found && (v.key != i * 37 || v.version != (i >= 500 && i < 510))) ok = false;
+		}
+		std::cout << "lookups " << ok << ", order " << same_order(map, ref) << std::endl;
+		//扩容会顺手把待释放的也放掉
+		copies = 0;
+		for (int i = 1000; i < 1200; ++i) {
+			map.insert(i * 37, Tracked(i * 37));
+			ref.push_back(i * 37);
+		}
+		std::cout << "grown: size " << map.size() << ", alive " << alive << ", copies " << copies << ", order "
+		          << same_order(map, ref) << std::endl;
+		std::cout << "insert existing " << map.insert(600 * 37, Tracked()) << ", value version ";
+		map.find(600 * 37, v);
+		std::cout << v.version << std::endl;
+	}
+	std::cout << "destroyed, alive " << alive << std::endl;
+}
+
+void test_readers() {
+	//读者不停地查，写者删、改、插、扩容；读到的值一定是完整的
+	Map map;
+	for (int i = 0; i < 1000; ++i) map.insert(i, Tracked(i, 0));
+	std::atomic<bool> stop(false);
+	std::atomic<int> broken(0);
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 2; ++r)
+		readers.push_back(std::thread([&]() {
+			Tracked v;
+			unsigned int x = 1;
+			while (!stop.load()) {
+				x = x * 1103515245u + 12345u;
+				int k = (int) (x >> 8) % 5000;
+				if (map.find(k, v) && (v.key != k || v.version < 0)) ++broken;
+			}
+		}));
+	for (int i = 0; i < 20000; ++i) {
+		int k = i % 5000;
+		if (i % 3 == 0) map.erase(k);
+		else if (i % 3 == 1) map.assign(k, Tracked(k, i));
+		else map.insert(k + 1, Tracked(k + 1, i));
+	}
+	stop = true;
+	for (auto &t : readers) t.join();
+	std::cout << "readers: broken " << broken << ", size " << map.size() << std::endl;
+}
+
+int main() {
+	test_single();
+	test_readers();
+	std::cout << "alive " << alive << std::endl;
+	return 0;
+}
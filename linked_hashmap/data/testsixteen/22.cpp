@@ -0,0 +1,115 @@
+#include "concurrent_linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+//分shard的表：for_each_ordered要把各个shard按全局插入顺序合回来；每个操作只算一次哈希
+std::atomic<long long> hash_calls(0);
+
+struct counting_hash {
+	size_t operator()(int x) const {
+		++hash_calls;
+		return std::hash<int>()(x);
+	}
+};
+
+typedef sjtu::concurrent_linked_hashmap<int, std::string, counting_hash> Map;
+
+std::vector<int> ordered_keys(const Map &map) {
+	std::vector<int> keys;
+	map.for_each_ordered([&](const int &k, const std::string &v) {
+		keys.push_back(k);
+		if (v != std::to_string(k) && v != "assigned " + std::to_string(k)) keys.push_back(-1);
+	});
+	return keys;
+}
+
+void test_ordered() {
+	Map map(8);
+	std::list<int> ref;
+	hash_calls = 0;
+	for (int i = 0; i < 1000; ++i) {
+		int k = i * 7919 % 10007;
+		map.insert(k, std::to_string(k));
+		ref.push_back(k);
+	}
+	std::cout << "1000 inserts: " << hash_calls << " hashes" << std::endl;
+	hash_calls = 0;
+	int dup = 0;
+	for (int i = 0; i < 100; ++i) dup += map.insert(i * 7919 % 10007, "duplicate");
+	std::cout << "100 duplicate inserts: " << dup << " inserted, " << hash_calls << " hashes" << std::endl;
+	hash_calls = 0;
+	//删掉一部分，再插回来的排到最后；assign已有的键顺序不变
+	int erased = 0, ops = 0;
+	for (int i = 0; i < 1000; i += 3, ++ops) {
+		int k = i * 7919 % 10007;
+		erased += map.erase(k);
+		ref.remove(k);
+	}
+	erased += map.erase(-5);
+	++ops;
+	for (int i = 0; i < 1000; i += 9, ++ops) {
+		int k = i * 7919 % 10007;
+		map.assign(k, "assigned " + std::to_string(k));
+		if (std::find(ref.begin(), ref.end(), k) == ref.end()) ref.push_back(k);
+	}
+	std::string value;
+	int found = 0;
+	for (int i = 0; i < 1000; ++i, ++ops) found += map.find(i * 7919 % 10007, value);
+	std::cout << "erased " << erased << ", found " << found << ", " << hash_calls << " hashes for "
+	          << ops << " operations" << std::endl;
+	std::vector<int> keys = ordered_keys(map);
+	std::cout << "ordered " << (keys == std::vector<int>(ref.begin(), ref.end())) << " size " << keys.size() << " "
+	          << map.size() << std::endl;
+	std::cout << "first";
+	for (int i = 0; i < 5; ++i) std::cout << " " << keys[i];
+	std::cout << ", last";
+	for (size_t i = keys.size() - 5; i < keys.size(); ++i) std::cout << " " << keys[i];
+	std::cout << std::endl;
+	//for_each按shard走，每个元素恰好一次
+	std::vector<int> visited;
+	map.for_each([&](const int &k, const std::string &) { visited.push_back(k); });
+	std::sort(visited.begin(), visited.end());
+	std::sort(keys.begin(), keys.end());
+	std::cout << "for_each visits each once " << (visited == keys) << std::endl;
+	map.clear();
+	std::cout << "cleared " << map.empty() << " " << ordered_keys(map).size() << std::endl;
+}
+
+void test_threads() {
+	//每个线程插自己的一段键：合并出来的全局顺序里，每个线程自己的键要按它插入的顺序出现
+	Map map(16);
+	const int threads = 4, per_thread = 20000;
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t)
+		workers.push_back(std::thread([&map, t]() {
+			for (int i = 0; i < per_thread; ++i) {
+				int k = t * per_thread + (i * 7) % per_thread;
+				map.insert(k, std::to_string(k));
+				if (i % 5 == 4) map.assign(k, "assigned " + std::to_string(k));
+			}
+		}));
+	for (auto &w : workers) w.join();
+	std::vector<int> keys = ordered_keys(map);
+	std::vector<int> position(threads, 0);
+	bool ordered = keys.size() == (size_t) threads * per_thread;
+	for (int k : keys) {
+		if (k < 0) {
+			ordered = false;
+			continue;
+		}
+		int t = k / per_thread, i = position[t]++;
+		if (k != t * per_thread + (i * 7) % per_thread) ordered = false;
+	}
+	std::cout << "threads: size " << map.size() << ", per-thread order kept " << ordered << std::endl;
+}
+
+int main() {
+	test_ordered();
+	test_threads();
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+
+//按插入顺序删一段、删最老的元素：检查剩下的元素、顺序和返回值，以及删到很少之后再插入
+typedef sjtu::linked_hashmap<int, std::string> Map;
+
+void print(const Map &map) {
+	std::cout << "size " << map.size() << ":";
+	for (auto it = map.cbegin(); it != map.cend(); ++it) std::cout << " " << it->first << "=" << it->second;
+	std::cout << std::endl;
+}
+
+Map::iterator nth(Map &map, int n) {
+	auto it = map.begin();
+	while (n--) ++it;
+	return it;
+}
+
+void test_range() {
+	Map map;
+	for (int i = 0; i < 10; ++i) map[i * 3] = std::to_string(i);
+	auto last = nth(map, 7);
+	auto ret = map.erase(nth(map, 2), last);
+	std::cout << "returned last " << (ret == last) << " " << ret->first << std::endl;
+	print(map);
+	//空区间什么也不删
+	ret = map.erase(nth(map, 1), nth(map, 1));
+	std::cout << "empty range " << ret->first << " ";
+	print(map);
+	//删到结尾
+	ret = map.erase(nth(map, 3), map.end());
+	std::cout << "to end " << (ret == map.end()) << " ";
+	print(map);
+	std::cout << "find erased " << (map.find(6) == map.end()) << " " << map.count(9) << " kept " << map.at(21)
+	          << std::endl;
+	ret = map.erase(map.begin(), map.end());
+	std::cout << "all " << map.empty() << " " << (map.begin() == map.end()) << std::endl;
+	map[1] = "one";
+	map[2] = "two";
+	print(map);
+}
+
+void test_invalid() {
+	Map a, b;
+	for (int i = 0; i < 5; ++i) a[i] = b[i] = "x";
+	int thrown = 0;
+	try {
+		a.erase(nth(a, 3), nth(a, 1));
+	} catch (sjtu::exception &) {
+		++thrown;
+	}
+	try {
+		a.erase(nth(a, 1), nth(b, 3));
+	} catch (sjtu::exception &) {
+		++thrown;
+	}
+	try {
+		a.erase(nth(b, 1), nth(b, 3));
+	} catch (sjtu::exception &) {
+		++thrown;
+	}
+	std::cout << "invalid ranges thrown " << thrown << ", untouched " << a.size() << " " << b.size() << std::endl;
+}
+
+void test_pop_front() {
+	Map map;
+	try {
+		map.pop_front();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty pop_front throws" << std::endl;
+	}
+	for (int i = 0; i < 6; ++i) map[i] = std::to_string(i * i);
+	map.pop_front();
+	map.pop_front();
+	print(map);
+	map[0] = "back";
+	map.pop_front();
+	print(map);
+	while (!map.empty()) map.pop_front();
+	try {
+		map.pop_front();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "drained pop_front throws" << std::endl;
+	}
+}
+
+void test_shrink() {
+	//删到只剩几个，表会缩小；之后再插入，顺序和查找都要对
+	Map map;
+	const int n = 100000;
+	for (int i = 0; i < n; ++i) map[i * 7] = std::to_string(i);
+	map.erase(nth(map, 5), nth(map, n - 5));
+	print(map);
+	for (int i = 0; i < 3; ++i) map.pop_front();
+	for (int i = 0; i < 1000; ++i) map[-i - 1] = std::to_string(-i - 1);
+	int count = 0;
+	bool ordered = true;
+	int expect = -1;
+	auto it = map.cbegin();
+	std::cout << "after shrink: head";
+	for (int i = 0; i < 7; ++i) std::cout << " " << (it++)->first;
+	for (; it != map.cend(); ++it, --expect) {
+		if (it->first != expect || map.at(expect) != std::to_string(expect)) ordered = false;
+		++count;
+	}
+	std::cout << ", size " << map.size() << " rest " << count << " ordered "
+	          << ordered << " found " << map.count(35) << map.count(-1000) << map.count(0) << std::endl;
+	while (map.size() > 1) map.erase(map.begin(), nth(map, map.size() / 2));
+	print(map);
+}
+
+int main() {
+	test_range();
+	test_invalid();
+	test_pop_front();
+	test_shrink();
+	return 0;
+}
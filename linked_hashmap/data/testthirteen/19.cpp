@@ -0,0 +1,128 @@
+#define SJTU_LINKEDHASHMAP_STATS
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <cstdlib>
+
+//渐进式rehash：桶数一变，旧表就留着慢慢搬，这段时间里的插入、删除、查找、重新插入都和一个参照模型对拍
+//stats()的直方图把旧表里还没搬的桶也算上，所以它的总数比bucket_count()多就说明旧表还在
+typedef sjtu::linked_hashmap<int, int> Map;
+
+bool migrating(const Map &map) {
+	sjtu::linked_hashmap_stats s = map.stats();
+	size_t buckets = 0;
+	for (int i = 0; i < sjtu::linked_hashmap_stats::histogram_size; ++i) buckets += s.chain_histogram[i];
+	return buckets > map.bucket_count();
+}
+
+struct model {
+	std::list<int> order;
+	std::unordered_map<int, std::pair<int, std::list<int>::iterator>> values;
+
+	void insert(int k, int v) {
+		order.push_back(k);
+		values[k] = {v, std::prev(order.end())};
+	}
+
+	void erase(int k) {
+		order.erase(values[k].second);
+		values.erase(k);
+	}
+};
+
+bool same(const Map &map, const model &ref) {
+	if (map.size() != ref.values.size()) return false;
+	auto it = map.cbegin();
+	for (int k : ref.order) {
+		if (it == map.cend() || it->first != k || it->second != ref.values.at(k).first) return false;
+		++it;
+	}
+	return it == map.cend();
+}
+
+void test_mixed() {
+	Map map;
+	model ref;
+	srand(37);
+	size_t buckets = map.bucket_count();
+	int watch = 0, grows = 0, shrinks = 0, windows = 0, started = 0, still = 0, ordered = 0;
+	bool ok = true;
+	for (int i = 0; i < 1000000; ++i) {
+		int op = rand() % 10, key = rand() % 200000;
+		bool present = ref.values.count(key) != 0;
+		//前面插得多，后面只删不插，表先扩再缩
+		bool growing = i < 200000;
+		if (op < (growing ? 5 : 0)) {
+			auto r = map.insert(sjtu::pair<const int, int>(key, i));
+			if (r.second == present) ok = false;
+			if (!present) ref.insert(key, i);
+		} else if (op < 7) {
+			auto it = map.find(key);
+			if ((it == map.end()) == present) ok = false;
+			if (present) {
+				map.erase(it);
+				ref.erase(key);
+			}
+		} else if (op < 9) {
+			const Map &c = map;
+			if (c.count(key) != (present ? 1u : 0u) || (present && c.at(key) != ref.values[key].first)) ok = false;
+		} else if (present) {
+			//删掉再插，排到最后
+			map.erase(map.find(key));
+			map[key] = -i;
+			ref.erase(key);
+			ref.insert(key, -i);
+		}
+		if (map.bucket_count() != buckets) {
+			if (map.bucket_count() > buckets) ++grows;
+			else ++shrinks;
+			buckets = map.bucket_count();
+			if (buckets >= 1000) {
+				//大表要搬几百次操作，在这段时间里盯着看
+				watch = 64;
+				++windows;
+				started += migrating(map);
+			}
+		}
+		if (watch > 0 && --watch == 0) {
+			still += migrating(map);
+			ordered += same(map, ref);
+		}
+	}
+	std::cout << "mixed: ok " << ok << ", grows " << grows << ", shrinks " << shrinks << ", windows " << windows << ", migrating at start " << started << ", after 64 ops "
+	          << still << ", ordered " << ordered << ", final " << same(map, ref) << " size " << map.size()
+	          << std::endl;
+}
+
+void test_during_migration() {
+	Map map;
+	model ref;
+	int i = 0;
+	while (map.bucket_count() < 8000) ref.insert(i, i), map[i] = i, ++i;
+	std::cout << "grew to " << map.bucket_count() << " at " << map.size() << ", migrating " << migrating(map);
+	//旧表里的和新表里的都有：从两头各删一些，中间删一段
+	for (int k = 0; k < 50; ++k) map.erase(map.find(k)), ref.erase(k);
+	for (int k = i - 50; k < i; ++k) map.erase(map.find(k)), ref.erase(k);
+	auto first = map.find(1000), last = map.find(2000);
+	map.erase(first, last);
+	for (int k = 1000; k < 2000; ++k) ref.erase(k);
+	std::cout << ", still " << migrating(map) << ", same " << same(map, ref);
+	Map copy(map), assigned;
+	assigned[-1] = -1;
+	assigned = map;
+	std::cout << ", copies " << same(copy, ref) << same(assigned, ref) << migrating(copy) << std::endl;
+	map.clear();
+	std::cout << "cleared while migrating: " << migrating(map) << " " << map.size() << " " << (map.begin() == map.end());
+	for (int k = 0; k < 100000; ++k) map[k * 3] = k;
+	bool ok = map.size() == 100000;
+	for (int k = 0; k < 100000; ++k)
+		if (map.at(k * 3) != k || map.count(k * 3 + 1)) ok = false;
+	std::cout << ", refilled " << ok << std::endl;
+}
+
+int main() {
+	test_mixed();
+	test_during_migration();
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "hash.hpp"
+#include "linked_hashmap.hpp"
+#include <iostream>
+#include <string>
+
+//桶数的变化：扩容经过一串素数（或2的幂），删到装载因子的1/4以下会缩，reserve/rehash换桶的时候迭代器不失效
+template<class Map>
+bool check(const Map &map, int first, int last, int step) {
+	//map里应该正好是 first, first+step, ... < last，按这个顺序
+	auto it = map.cbegin();
+	size_t n = 0;
+	for (int k = first; k < last; k += step, ++it, ++n)
+		if (it == map.cend() || it->first != k || it->second != std::to_string(k) || map.count(k) != 1) return false;
+	return it == map.cend() && n == map.size() && map.count(last) == 0;
+}
+
+template<class Map>
+void test_grow_shrink(const char *name) {
+	Map map;
+	std::cout << name << std::endl << "grow:";
+	size_t buckets = map.bucket_count();
+	std::cout << " " << buckets;
+	bool ok = true;
+	for (int i = 0; i < 100000; ++i) {
+		map[i] = std::to_string(i);
+		if (map.bucket_count() != buckets) {
+			buckets = map.bucket_count();
+			std::cout << " " << buckets << "@" << map.size();
+			if (!check(map, 0, i + 1, 1)) ok = false;
+		}
+	}
+	std::cout << std::endl << "ordered " << ok << " " << check(map, 0, 100000, 1) << " load "
+	          << (map.load_factor() <= map.max_load_factor()) << std::endl;
+	//从前面删，每删到桶数变化就检查一遍
+	std::cout << "shrink:";
+	for (int i = 0; i < 99990; ++i) {
+		map.erase(map.find(i));
+		if (map.bucket_count() != buckets) {
+			buckets = map.bucket_count();
+			std::cout << " " << buckets << "@" << map.size();
+			if (!check(map, i + 1, 100000, 1)) ok = false;
+		}
+	}
+	std::cout << std::endl << "ordered " << ok << " " << check(map, 99990, 100000, 1) << std::endl;
+	for (int i = 0; i < 99990; ++i) map.erase(map.find(99990 + i % 10)), map[99990 + i % 10] = std::to_string(99990 + i % 10);
+	std::cout << "churn at 10 elements: buckets " << map.bucket_count() << " " << check(map, 99990, 100000, 1)
+	          << std::endl;
+}
+
+void test_iterators() {
+	sjtu::linked_hashmap<int, std::string> map;
+	for (int i = 0; i < 1000; i += 2) map[i] = std::to_string(i);
+	auto first = map.begin(), middle = map.find(500), last = map.find(998);
+	sjtu::pair<const int, std::string> *address = &*middle;
+	bool ok = true;
+	//reserve/rehash/max_load_factor 都会重建桶数组，节点不动
+	map.reserve(200000);
+	std::cout << "reserve: buckets " << map.bucket_count();
+	if (first->first != 0 || &*middle != address || middle->second != "500" || (++last) != map.end()) ok = false;
+	for (int i = 1; i < 1000; i += 2) map[i] = std::to_string(i);
+	map.rehash(10);
+	std::cout << ", rehash(10): " << map.bucket_count();
+	map.max_load_factor(0.25f);
+	std::cout << ", max_load 0.25: " << map.bucket_count();
+	map.max_load_factor(4.0f);
+	map.rehash(0);
+	std::cout << ", max_load 4 rehash(0): " << map.bucket_count() << std::endl;
+	//middle往后走：先是原来的偶数，再是后插的奇数
+	int steps = 0;
+	for (auto it = middle; it != map.end(); ++it, ++steps) {
+		int expect = steps < 250 ? 500 + 2 * steps : 1 + 2 * (steps - 250);
+		if (it->first != expect) ok = false;
+	}
+	std::cout << "iterators valid " << ok << " " << steps << " " << (&*map.find(500) == address) << " "
+	          << map.size() << std::endl;
+	map.max_load_factor(1.0f);
+	int thrown = 0;
+	try {
+		map.max_load_factor(0);
+	} catch (sjtu::runtime_error &) {
+		++thrown;
+	}
+	try {
+		map.max_load_factor(-1);
+	} catch (sjtu::runtime_error &) {
+		++thrown;
+	}
+	std::cout << "bad max_load_factor thrown " << thrown << " " << map.max_load_factor() << std::endl;
+}
+
+int main() {
+	test_grow_shrink<sjtu::linked_hashmap<int, std::string>>("prime buckets (std::hash)");
+	test_grow_shrink<sjtu::linked_hashmap<int, std::string, sjtu::int_hash>>("power of two buckets (int_hash)");
+	test_iterators();
+	return 0;
+}
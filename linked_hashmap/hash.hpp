@@ -0,0 +1,249 @@
+//几个快的哈希函数，可以直接当linked_hashmap的Hash用
+#ifndef SJTU_HASH_HPP
+#define SJTU_HASH_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace sjtu {
+
+    /**
+     * how linked_hashmap turns a hash value into a bucket index.
+     *
+     * prime_modulo: h % (a prime number of buckets), safe even when h is weak (std::hash of an integer is h itself),
+     *   but costs an integer division.
+     * power_of_two_mask: h & (2^k - 1), the cheapest, but only uses the low bits, so the hash must mix well.
+     * power_of_two_fibonacci: the high k bits of h * 2^64 / phi, which spreads out weak hashes as well.
+     */
+    enum bucket_reduction {
+        prime_modulo, power_of_two_mask, power_of_two_fibonacci
+    };
+
+    template<class...>
+    struct make_void {
+        typedef void type;
+    };
+
+    /**
+     * the bucket_reduction a linked_hashmap uses with Hash.
+     * a Hash declaring is_avalanching (every output bit depends on every input bit, like the ones below)
+     *   gets power_of_two_mask, everything else prime_modulo.
+     * specialize it to pick another one, e.g. power_of_two_fibonacci for a cheap hash of your own.
+     */
+    template<class Hash, class = void>
+    struct hash_reduction {
+        static const bucket_reduction value = prime_modulo;
+    };
+
+    template<class Hash>
+    struct hash_reduction<Hash, typename make_void<typename Hash::is_avalanching>::type> {
+        static const bucket_reduction value = power_of_two_mask;
+    };
+
+    namespace hash_detail {
+        inline unsigned long long read64(const unsigned char *p) {
+            unsigned long long v;
+            memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline unsigned long long read32(const unsigned char *p) {
+            unsigned int v;
+            memcpy(&v, p, 4);
+            return v;
+        }
+
+        //64位乘64位得到128位，返回高低两半
+        inline void multiply(unsigned long long &a, unsigned long long &b) {
+            unsigned __int128 r = (unsigned __int128) a * b;
+            a = (unsigned long long) r;
+            b = (unsigned long long) (r >> 64);
+        }
+
+        inline unsigned long long fold_multiply(unsigned long long a, unsigned long long b) {
+            multiply(a, b);
+            return a ^ b;
+        }
+
+        inline unsigned long long avalanche(unsigned long long h) {
+            h ^= h >> 37;
+            h *= 0x165667919E3779F9ull;
+            return h ^ (h >> 32);
+        }
+
+        const unsigned long long wy_secret[4] = {
+                0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+        };
+
+        const unsigned long long xxh_secret[16] = {
+                0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+                0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull,
+                0xcb00c391bb52283cull, 0xa32e531b8b65d088ull, 0x4ef90da297486471ull, 0xd8acdea946ef1938ull,
+                0x3f349ce33f76faa8ull, 0x1d4f0bc7c7bbdcf9ull, 0x3159b4cd4be0518aull, 0x647378d9c97e9fc8ull
+        };
+
+        inline unsigned long long xxh_mix16(const unsigned char *p, const unsigned long long *secret,
+                                            unsigned long long seed) {
+            return fold_multiply(read64(p) ^ (secret[0] + seed), read64(p + 8) ^ (secret[1] - seed));
+        }
+
+        //一个64字节的stripe分给8个累加器，每个累加器一条独立的链
+        inline void xxh_accumulate(unsigned long long *acc, const unsigned char *stripe,
+                                   const unsigned long long *key_lanes) {
+            for (int i = 0; i < 8; ++i) {
+                unsigned long long data = read64(stripe + 8 * i);
+                unsigned long long k = data ^ key_lanes[i];
+                acc[i ^ 1] += data;
+                acc[i] += (k & 0xffffffffull) * (k >> 32);
+            }
+        }
+    }
+
+    /**
+     * wyhash (final version 4) of len bytes at key.
+     */
+    inline unsigned long long wyhash_bytes(const void *key, size_t len, unsigned long long seed = 0) {
+        using namespace hash_detail;
+        const unsigned char *p = (const unsigned char *) key;
+        const unsigned long long *s = wy_secret;
+        seed ^= fold_multiply(seed ^ s[0], s[1]);
+        unsigned long long a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+            } else if (len > 0) {
+                a = ((unsigned long long) p[0] << 16) | ((unsigned long long) p[len >> 1] << 8) | p[len - 1];
+                b = 0;
+            } else a = b = 0;
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                //三条链交错，互相不依赖，乘法可以并行
+                unsigned long long see1 = seed, see2 = seed;
+                do {
+                    seed = fold_multiply(read64(p) ^ s[1], read64(p + 8) ^ seed);
+                    see1 = fold_multiply(read64(p + 16) ^ s[2], read64(p + 24) ^ see1);
+                    see2 = fold_multiply(read64(p + 32) ^ s[3], read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = fold_multiply(read64(p) ^ s[1], read64(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+        a ^= s[1];
+        b ^= seed;
+        multiply(a, b);
+        return fold_multiply(a ^ s[0] ^ len, b ^ s[1]);
+    }
+
+    /**
+     * a hash in the style of XXH3 (not bit-compatible with it):
+     * short inputs are folded with one or two 128-bit multiplies,
+     * long inputs go through 8 independent lanes per 64-byte stripe, which compilers vectorize;
+     *   the last 64 bytes are always one more stripe (overlapping the previous one), so every byte counts.
+     */
+    inline unsigned long long xxh3_bytes(const void *key, size_t len, unsigned long long seed = 0) {
+        using namespace hash_detail;
+        const unsigned char *p = (const unsigned char *) key;
+        const unsigned long long *s = xxh_secret;
+        if (len <= 16) {
+            unsigned long long lo, hi;
+            if (len > 8) {
+                lo = read64(p);
+                hi = read64(p + len - 8);
+            } else if (len >= 4) {
+                lo = read32(p);
+                hi = read32(p + len - 4);
+            } else if (len > 0) {
+                lo = ((unsigned long long) p[0] << 16) | ((unsigned long long) p[len >> 1] << 8) | p[len - 1];
+                hi = 0;
+            } else return avalanche(seed ^ s[0] ^ s[1]);
+            return avalanche(fold_multiply(lo ^ (s[2] + seed), hi ^ (s[3] - seed)) + len);
+        }
+        unsigned long long h = len * 0x9E3779B185EBCA87ull;
+        if (len <= 128) {
+            //从两头往中间，每次各取16个字节
+            size_t pairs = (len - 1) / 32 + 1;
+            for (size_t i = 0; i < pairs; ++i) {
+                h += xxh_mix16(p + 16 * i, s + 4 * i % 16, seed);
+                h += xxh_mix16(p + len - 16 * (i + 1), s + (4 * i + 2) % 16, seed);
+            }
+            return avalanche(h);
+        }
+        unsigned long long acc[8];
+        for (int i = 0; i < 8; ++i)acc[i] = s[i] + seed;
+        //最后一个stripe不在这里算，哪怕它是完整的
+        size_t stripes = (len - 1) / 64;
+        for (size_t n = 0; n < stripes; ++n) {
+            xxh_accumulate(acc, p + 64 * n, s + (n % 8));
+            //每16个stripe打乱一次，免得累加器的高位一直不参与
+            if ((n & 15) == 15)for (int i = 0; i < 8; ++i)acc[i] = (acc[i] ^ (acc[i] >> 47) ^ s[8 + i]) * 0x9E3779B1u;
+        }
+        //和XXH3一样，最后64个字节单独当一个stripe，换一段密钥，不满一个stripe的尾巴也就算进去了
+        xxh_accumulate(acc, p + len - 64, s + 7);
+        for (int i = 0; i < 8; i += 2)h += fold_multiply(acc[i] ^ s[8 + i], acc[i + 1] ^ s[9 + i]);
+        return avalanche(h);
+    }
+
+    /**
+     * hash functors for linked_hashmap.
+     * std::string keys can also be looked up with a const char * without building a string (is_transparent).
+     */
+    struct wyhash {
+        typedef void is_transparent;
+        typedef void is_avalanching;
+
+        size_t operator()(const std::string &s) const {
+            return (size_t) wyhash_bytes(s.data(), s.size());
+        }
+
+        size_t operator()(const char *s) const {
+            return (size_t) wyhash_bytes(s, strlen(s));
+        }
+    };
+
+    struct xxh3_hash {
+        typedef void is_transparent;
+        typedef void is_avalanching;
+
+        size_t operator()(const std::string &s) const {
+            return (size_t) xxh3_bytes(s.data(), s.size());
+        }
+
+        size_t operator()(const char *s) const {
+            return (size_t) xxh3_bytes(s, strlen(s));
+        }
+    };
+
+    /**
+     * for integer keys: the murmur3 finalizer, a few multiplies and shifts.
+     * sequential or strided keys come out spread over all 64 bits.
+     */
+    struct int_hash {
+        typedef void is_avalanching;
+
+        template<class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
+        size_t operator()(T key) const {
+            unsigned long long h = (unsigned long long) key;
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return (size_t) h;
+        }
+    };
+
+}
+
+#endif
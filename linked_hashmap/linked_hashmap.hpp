@@ -6,11 +6,90 @@
 
 // only for std::equal_to<T> and std::hash<T>
 #include <functional>
+#include <cmath>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "hash.hpp"
+#ifdef SJTU_LINKEDHASHMAP_STATS
+#include <atomic>
+#include <chrono>
+#endif
 
 namespace sjtu {
+    /**
+     * the binary snapshot written by linked_hashmap::save(), also served directly by linked_hashmap_image:
+     *   the header (padded to entries_offset bytes),
+     *   count entries in insertion order,
+     *   bucket_count indices of the first entry of every bucket (no_entry for an empty bucket).
+     * an entry lives in bucket hash_code % bucket_count, the chain goes on through next.
+     * the file is only meant to be read back on the same kind of machine, with the same Key, T and Hash.
+     */
+    struct linked_hashmap_image_header {
+        char magic[8];
+        unsigned long long key_size;
+        unsigned long long value_size;
+        unsigned long long entry_size;
+        unsigned long long count;
+        unsigned long long bucket_count;
+        float max_load;
+
+        static const size_t entries_offset = 64;
+        static const unsigned int no_entry = 0xffffffffu;
+
+        static const char *expected_magic() {
+            return "SJTULHM1";
+        }
+    };
+
+    template<class Key, class T>
+    struct linked_hashmap_image_entry {
+        Key first;
+        T second;
+        unsigned long long hash_code;
+        unsigned int next;
+    };
+
+#ifdef SJTU_LINKEDHASHMAP_STATS
+    /**
+     * a snapshot of how a linked_hashmap is doing, returned by linked_hashmap::stats().
+     * only there when SJTU_LINKEDHASHMAP_STATS is defined before including linked_hashmap.hpp;
+     *   without it the map keeps no counters at all.
+     *
+     * chain_histogram[i] is the number of buckets holding i elements, the last one counts every longer chain too.
+     * lookups / probes: chain searches (find, count, at, operator[], the check before inserting) and
+     *   the elements compared on the way, since construction or the last reset_stats();
+     *   they are relaxed atomics, so const lookups from several threads (e.g. concurrent_linked_hashmap's
+     *   readers under a shared lock) can count at the same time.
+     * rehash_seconds includes the incremental migration spread over later operations;
+     *   to keep clock reads cheap only one migration step in 16 is timed (minus the cost of reading the clock)
+     *   and counted 16 times, so that part is an estimate. the migration schedule itself is the same as without stats.
+     * bytes covers the map object, the bucket arrays and the node blocks (free nodes included),
+     *   not memory owned by the keys and values themselves.
+     */
+    struct linked_hashmap_stats {
+        static const int histogram_size = 16;
+
+        size_t size;
+        size_t bucket_count;
+        float load_factor;
+        size_t chain_histogram[histogram_size];
+        size_t max_chain;
+        unsigned long long lookups;
+        unsigned long long probes;
+        double average_probes;
+        unsigned long long rehashes;
+        double rehash_seconds;
+        size_t bytes;
+        double bytes_per_entry;
+    };
+#endif
+
     /**
      * In linked_hashmap, iteration ordering is differ from map,
      * which is the order in which keys were inserted into the map.
@@ -36,36 +115,18 @@ namespace sjtu {
          */
         typedef pair<const Key, T> value_type;
 
+        //键值对直接放在节点里，一个元素只分配一次
+        //hash_code存完整的哈希值：走链时先比哈希值，rehash时也不用再算
         struct node {
-            value_type *value;
+            value_type value;
+            size_t hash_code;
             node *before = nullptr;
             node *after = nullptr;
             node *next = nullptr;
 
-            node(value_type v) {
-                value = (value_type *) malloc(sizeof(value_type));
-                new(value)value_type(v);
-            }
-
-            node(const node &other) {
-                value = (value_type *) malloc(sizeof(value));
-                new(value)value_type(*(other.value));
-                next = other.next;
-                after = other.after;
-                before = other.before;
-            }
-
-            node() {
-                value = nullptr;
-            }
-
-            ~node() {
-                if (value != nullptr) {
-                    value->second.~T();
-                    value->first.~Key();
-                    free(value);
-                }
-            }
+            //args直接拿来构造value，不经过临时的value_type
+            template<class... Args>
+            explicit node(size_t h, Args &&... args) : value(std::forward<Args>(args)...), hash_code(h) {}
         };
 
 
@@ -109,6 +170,8 @@ namespace sjtu {
                 me = other.me;
             }
 
+            iterator &operator=(const iterator &other) = default;
+
             iterator operator++(int) {
                 if (ptr == nullptr) {
                     runtime_error e;
@@ -129,7 +192,7 @@ namespace sjtu {
             }
 
             iterator operator--(int) {
-                if (ptr == me->head->after) {
+                if (ptr == me->head) {
                     runtime_error e;
                     throw e;
                 }
@@ -140,7 +203,7 @@ namespace sjtu {
             }
 
             iterator &operator--() {
-                if (ptr == me->head->after) {
+                if (ptr == me->head) {
                     runtime_error e;
                     throw e;
                 }
@@ -153,11 +216,11 @@ namespace sjtu {
              * a operator to check whether two iterators are same (pointing to the same memory).
              */
             value_type &operator*() const {
-                if (ptr == me->head || ptr == nullptr) {
+                if (ptr == nullptr) {
                     runtime_error e;
                     throw e;
                 }
-                return *(ptr->value);
+                return ptr->value;
             }
 
             bool operator==(const iterator &rhs) const {
@@ -191,12 +254,12 @@ namespace sjtu {
              * for the support of it->first.
              * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
              */
-            value_type *operator->() const noexcept {
-                if (ptr == me->head || ptr == nullptr) {
+            value_type *operator->() const {
+                if (ptr == nullptr) {
                     runtime_error e;
                     throw e;
                 }
-                return ptr->value;
+                return &ptr->value;
             }
         };
 
@@ -238,6 +301,8 @@ namespace sjtu {
                 me = other.me;
             }
 
+            const_iterator &operator=(const const_iterator &other) = default;
+
 
             const_iterator operator++(int) {
                 if (ptr == nullptr) {
@@ -259,7 +324,7 @@ namespace sjtu {
             }
 
             const_iterator operator--(int) {
-                if (ptr == me->head->after) {
+                if (ptr == me->head) {
                     runtime_error e;
                     throw e;
                 }
@@ -270,7 +335,7 @@ namespace sjtu {
             }
 
             const_iterator &operator--() {
-                if (ptr == me->head->after) {
+                if (ptr == me->head) {
                     runtime_error e;
                     throw e;
                 }
@@ -283,11 +348,11 @@ namespace sjtu {
              * a operator to check whether two iterators are same (pointing to the same memory).
              */
             value_type &operator*() const {
-                if (ptr == me->head || ptr == nullptr) {
+                if (ptr == nullptr) {
                     runtime_error e;
                     throw e;
                 }
-                return *(ptr->value);
+                return ptr->value;
             }
 
             bool operator==(const iterator &rhs) const {
@@ -322,11 +387,11 @@ namespace sjtu {
              * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
              */
             value_type *operator->() {
-                if (ptr == me->head || ptr == nullptr) {
+                if (ptr == nullptr) {
                     runtime_error e;
                     throw e;
                 }
-                return ptr->value;
+                return &ptr->value;
             }
         };
 
@@ -334,136 +399,459 @@ namespace sjtu {
         Hash hash;
         Equal equal;
         unsigned int scale = 0;
-        node *head;
-        node *rear;
+        node *head;//插入顺序的第一个元素，空的时候是nullptr
+        node *rear;//插入顺序的最后一个元素
     public:
-        node **data;//new 出来的东西就是头节点
-        unsigned int array_size = 41519;
+        node **data;//每个桶存的是链上的第一个节点，空桶是nullptr
+        unsigned int array_size = bucket_count_for(0);
+        float max_load = 1.0f;
 
     private:
-        pair<node *, bool> insert_(value_type v) {
-            unsigned int index = hash.operator()(v.first) % array_size;
-            node *ptr = data[index];
-            while (ptr->next != nullptr) {
-                if (equal.operator()(ptr->next->value->first, v.first))break;
-                ptr = ptr->next;
-            }
-            //现在ptr->next是相等的,或者说是ptr->next=nullptr
-            if (ptr->next)return {ptr->next, false};
+        //渐进式rehash：扩容/缩容时旧表留着，每次操作搬几个桶过去，搬完就释放
+        //旧表中下标 >= rehash_index 的桶还没有搬，这些桶里的键（包括新插入的）都在旧表里
+        node **old_data = nullptr;
+        unsigned int old_size = 0;
+        unsigned int rehash_index = 0;
+        static const unsigned int rehash_step = 2;
+
+#ifdef SJTU_LINKEDHASHMAP_STATS
+        //只在定义了SJTU_LINKEDHASHMAP_STATS的时候才有，见stats()
+        struct stats_counters {
+            std::atomic<unsigned long long> lookups{0};//const的查找会在多个读者里同时计数
+            std::atomic<unsigned long long> probes{0};
+            unsigned long long rehashes = 0;
+            unsigned long long rehash_nanoseconds = 0;
+            unsigned long long migrate_steps = 0;
+            size_t node_bytes = 0;
+        };
+
+        mutable stats_counters counters;//const的find也要计数
+
+        //一次查找在本地数比较了几次，结束的时候再一起加到共享的计数上
+        class lookup_counter {
+            stats_counters &counters;
+
+        public:
+            unsigned long long probes = 0;
+
+            explicit lookup_counter(stats_counters &c) : counters(c) {}
+
+            ~lookup_counter() {
+                counters.lookups.fetch_add(1, std::memory_order_relaxed);
+                counters.probes.fetch_add(probes, std::memory_order_relaxed);
+            }
+        };
+
+        static unsigned long long nanoseconds_since(std::chrono::steady_clock::time_point start) {
+            return (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+        }
+
+        //两次读时钟之间最少隔多久，抽样计时的时候要减掉
+        static unsigned long long clock_overhead() {
+            static const unsigned long long overhead = []() {
+                unsigned long long best = ~0ull;
+                for (int i = 0; i < 16; ++i) {
+                    unsigned long long t = nanoseconds_since(std::chrono::steady_clock::now());
+                    if (t < best)best = t;
+                }
+                return best;
+            }();
+            return overhead;
+        }
+
+        //构造时开始计时，析构时把经过的时间乘上weight记到rehash上；weight是0就不读时钟
+        class rehash_timer {
+            stats_counters &counters;
+            unsigned int weight;
+            std::chrono::steady_clock::time_point start;
+
+        public:
+            rehash_timer(stats_counters &c, unsigned int w) : counters(c), weight(w) {
+                if (weight != 0)start = std::chrono::steady_clock::now();
+            }
+
+            ~rehash_timer() {
+                if (weight == 0)return;
+                unsigned long long t = nanoseconds_since(start), overhead = weight > 1 ? clock_overhead() : 0;
+                counters.rehash_nanoseconds += weight * (t > overhead ? t - overhead : 0);
+            }
+        };
+#endif
+
+    private:
+        //节点按块分配，块用prev串起来，整个表清空或析构的时候一起free
+        //删掉的节点放到free_list上，下次插入先用它们
+        struct block {
+            block *prev;
+        };
+
+        static const size_t block_header = (sizeof(block) + alignof(node) - 1) / alignof(node) * alignof(node);
+        block *blocks = nullptr;
+        node *cursor = nullptr;//当前块里还没用过的部分是[cursor, cursor_end)
+        node *cursor_end = nullptr;
+        node *free_list = nullptr;//空闲节点的存储，用开头的一个指针串起来
+
+        void new_block(size_t n) {
+            char *memory = (char *) malloc(block_header + sizeof(node) * n);
+            block *b = (block *) memory;
+            b->prev = blocks;
+            blocks = b;
+            cursor = (node *) (memory + block_header);
+            cursor_end = cursor + n;
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            counters.node_bytes += block_header + sizeof(node) * n;
+#endif
+        }
+
+        //只拿到存储，节点要自己构造
+        node *allocate() {
+            if (free_list != nullptr) {
+                node *p = free_list;
+                free_list = *(node **) p;
+                return p;
+            }
+            //块的大小跟着元素个数涨，元素越多一块越大
+            if (cursor == cursor_end)new_block(scale < 16 ? 16 : (scale > 65536 ? 65536 : scale));
+            return cursor++;
+        }
+
+        void release(node *p) {
+            p->~node();
+            *(node **) p = free_list;
+            free_list = p;
+        }
+
+        //所有节点都已经析构了才能调用
+        void free_blocks() {
+            while (blocks != nullptr) {
+                block *prev = blocks->prev;
+                free((void *) blocks);
+                blocks = prev;
+            }
+            cursor = cursor_end = free_list = nullptr;
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            counters.node_bytes = 0;
+#endif
+        }
+
+        template<class... Args>
+        node *new_node(size_t h, Args &&... args) {
+            return new(allocate())node(h, std::forward<Args>(args)...);
+        }
+
+        //要放n个新节点：空闲的不够就直接开一块能放下n个的
+        void reserve_nodes(size_t n) {
+            if (free_list == nullptr && (size_t) (cursor_end - cursor) < n)new_block(n);
+        }
+
+        //前向迭代器可以先数出有多少个，输入迭代器只能走一遍，就不数了
+        template<class InputIt>
+        static size_t range_size(InputIt first, InputIt last, std::true_type) {
+            return (size_t) std::distance(first, last);
+        }
+
+        template<class InputIt>
+        static size_t range_size(InputIt, InputIt, std::false_type) {
+            return 0;
+        }
+
+        template<class InputIt>
+        void prepare_range(InputIt first, InputIt last) {
+            typedef typename std::iterator_traits<InputIt>::iterator_category category;
+            size_t n = range_size(first, last, std::is_base_of<std::forward_iterator_tag, category>());
+            if (n == 0)return;
+            reserve(scale + n);
+            reserve_nodes(n);
+        }
+
+        //哈希值怎么变成桶的下标，由Hash决定，见hash.hpp
+        static const bucket_reduction reduction = hash_reduction<Hash>::value;
+
+        static unsigned int index_of(size_t h, unsigned int size) {
+            if (reduction == prime_modulo)return (unsigned int) (h % size);
+            if (reduction == power_of_two_mask)return (unsigned int) (h & (size - 1));
+            return (unsigned int) (((unsigned long long) h * 0x9E3779B97F4A7C15ull) >> (64 - __builtin_ctz(size)));
+        }
+
+        //取模的时候桶数都取素数，否则取2的幂，大约每次翻倍
+        static unsigned int bucket_count_for(size_t n) {
+            if (reduction != prime_modulo) {
+                unsigned int p = 16;
+                while (p < n && p < (1u << 31))p <<= 1;
+                return p;
+            }
+            static const unsigned int primes[] = {
+                    13, 29, 59, 127, 257, 521, 1049, 2099, 4201, 8419, 16843, 33703, 67409, 134837,
+                    269683, 539389, 1078787, 2157587, 4315183, 8630387, 17260781, 34521589, 69043189,
+                    138086407, 276172823, 552345671, 1104691373, 2209382761u
+            };
+            for (unsigned int p : primes)if (p >= n)return p;
+            return primes[sizeof(primes) / sizeof(primes[0]) - 1];
+        }
+
+        //挂到新表对应的桶里，桶内的顺序无所谓，直接放在最前面
+        void link(node *now) {
+            node *&bucket = data[index_of(now->hash_code, array_size)];
+            now->next = bucket;
+            bucket = now;
+        }
+
+        //接到插入顺序的最后
+        void append(node *now) {
+            if (rear == nullptr)head = now;
             else {
-                ptr->next = new node(v);
-                ptr = ptr->next;
+                rear->after = now;
+                now->before = rear;
             }
-            //现在ptr就是刚刚新加入的元素
-            rear->after = ptr;
-            ptr->before = rear;
-            rear = ptr;
-            return {ptr, true};
+            rear = now;
         }
 
-        void remove_(const Key &key) {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index];
-            while (ptr->next != nullptr) {
-                if (equal.operator()(ptr->next->value->first, key))break;//找到了要删除的元素
-                else ptr = ptr->next;
+        //从插入顺序的链表上摘下来，桶里的链不动
+        void unlink(node *now) {
+            if (now->before)now->before->after = now->after;
+            else head = now->after;
+            if (now->after)now->after->before = now->before;
+            else rear = now->before;
+            now->before = now->after = nullptr;
+        }
+
+        //把所有元素按插入顺序重新挂到新的桶里，节点本身不动，迭代器不会失效
+        void rebuild(unsigned int new_size) {
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            ++counters.rehashes;
+            rehash_timer timer(counters, 1);
+#endif
+            delete[]old_data;
+            old_data = nullptr;
+            delete[]data;
+            array_size = new_size;
+            data = new node *[array_size]();
+            for (node *ptr = head; ptr != nullptr; ptr = ptr->after)link(ptr);
+        }
+
+        //开始渐进式rehash：当前的表变成旧表，新表先是空的
+        void start_rehash(unsigned int new_size) {
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            ++counters.rehashes;
+            rehash_timer timer(counters, 1);
+#endif
+            old_data = data;
+            old_size = array_size;
+            rehash_index = 0;
+            array_size = new_size;
+            data = new node *[array_size]();
+        }
+
+        //搬最多n个非空的桶，空桶最多看10n个，和redis一样
+        void migrate(unsigned int n) {
+            if (old_data == nullptr)return;
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            //读一次时钟比搬两个桶还慢，只给每16步里的一步计时，算16份，搬桶的节奏不变
+            rehash_timer timer(counters, ++counters.migrate_steps % 16 == 0 ? 16 : 0);
+#endif
+            unsigned int empty_visits = n * 10;
+            while (n > 0 && rehash_index < old_size) {
+                node *ptr = old_data[rehash_index];
+                if (ptr == nullptr) {
+                    ++rehash_index;
+                    if (--empty_visits == 0)break;
+                    continue;
+                }
+                while (ptr != nullptr) {
+                    node *next = ptr->next;
+                    link(ptr);
+                    ptr = next;
+                }
+                old_data[rehash_index] = nullptr;
+                ++rehash_index;
+                --n;
             }
-            if (ptr->next) {
-                //ptr->next就是要删除的那个元素。
-                node *del = ptr->next;
-                ptr->next = ptr->next->next;
-                if (del == rear)rear = del->before;
-                if (del->after) del->after->before = del->before;
-                if (del->before)del->before->after = del->after;
-                delete del;
-            } else {
-                index_out_of_bound e;
+            if (rehash_index == old_size) {
+                delete[]old_data;
+                old_data = nullptr;
+            }
+        }
+
+        //哈希值为h的键所在（或者应该插入）的桶
+        node *&bucket_at(size_t h) const {
+            if (old_data != nullptr) {
+                unsigned int index = index_of(h, old_size);
+                if (index >= rehash_index)return old_data[index];
+            }
+            return data[index_of(h, array_size)];
+        }
+
+        //max_load_factor()和load()共用：正的有限数，inf会让表永远不扩容，NaN让所有比较都不成立
+        static bool valid_max_load(float ml) {
+            return ml > 0 && std::isfinite(ml);
+        }
+
+        //装载因子超过max_load就扩大一倍，正在rehash的时候先不管
+        void grow() {
+            if (old_data == nullptr && scale > array_size * max_load)
+                start_rehash(bucket_count_for((size_t) array_size * 2));
+        }
+
+        //装载因子掉到max_load的1/4以下就缩到一半左右，留出余量避免来回缩放
+        void shrink() {
+            if (old_data == nullptr && array_size > bucket_count_for(0) && scale < array_size * max_load / 4)
+                start_rehash(bucket_count_for((size_t) (scale * 2 / max_load) + 1));
+        }
+
+        //在桶里找key，找到了返回那个节点；没找到返回nullptr，这时link指向链尾的next，新节点挂在那里
+        //link指向链上的某个next指针，这样桶里的第一个节点不用特判
+        //调用之前先migrate，拿到link之后到挂上新节点之前都不能再搬桶
+        template<class K>
+        node *locate(const K &key, size_t h, node **&link) {
+            link = &bucket_at(h);
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            lookup_counter counting(counters);
+#endif
+            while (*link != nullptr) {
+#ifdef SJTU_LINKEDHASHMAP_STATS
+                ++counting.probes;
+#endif
+                if ((*link)->hash_code == h && equal.operator()((*link)->value.first, key))return *link;
+                link = &(*link)->next;
+            }
+            return nullptr;
+        }
+
+        node *attach(node **link, node *now) {
+            *link = now;
+            append(now);
+            scale++;
+            grow();
+            return now;
+        }
+
+        pair<node *, bool> insert_(const value_type &v) {
+            migrate(rehash_step);
+            size_t h = hash.operator()(v.first);
+            node **link;
+            node *found = locate(v.first, h, link);
+            if (found != nullptr)return {found, false};
+            return {attach(link, new_node(h, v)), true};
+        }
+
+        //键还没有的时候才用args构造新节点
+        template<class K, class... Args>
+        pair<node *, bool> try_emplace_(K &&key, Args &&... args) {
+            size_t h = hash.operator()(key);
+            return try_emplace_hashed_(h, std::forward<K>(key), std::forward<Args>(args)...);
+        }
+
+        //h必须是hash(key)；K可以不是Key（异构的operator[]），新节点的Key从key构造
+        template<class K, class... Args>
+        pair<node *, bool> try_emplace_hashed_(size_t h, K &&key, Args &&... args) {
+            migrate(rehash_step);
+            node **link;
+            node *found = locate(key, h, link);
+            if (found != nullptr)return {found, false};
+            node *now = new_node(h, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+            return {attach(link, now), true};
+        }
+
+        //删掉del这个节点：用存下来的哈希值找到桶，在链上找到指向它的指针，不用再算哈希、比较键
+        void remove_(node *del) {
+            migrate(rehash_step);
+            node **ptr = &bucket_at(del->hash_code);
+            while (*ptr != nullptr && *ptr != del)ptr = &(*ptr)->next;
+            if (*ptr == nullptr) {//不是这个表里的节点
+                runtime_error e;
                 throw e;
             }
+            *ptr = del->next;
+            unlink(del);
+            release(del);
+            scale--;
         }
 
-        node *find_(const Key &key) const {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index]->next;
+        //h必须是hash(key)，K可以不是Key，只要Equal能拿它和Key比较
+        template<class K>
+        node *find_(const K &key, size_t h) const {
+            node *ptr = bucket_at(h);
+#ifdef SJTU_LINKEDHASHMAP_STATS
+            lookup_counter counting(counters);
+#endif
             while (ptr != nullptr) {
-                if (equal.operator()(ptr->value->first, key))return ptr;
+#ifdef SJTU_LINKEDHASHMAP_STATS
+                ++counting.probes;
+#endif
+                if (ptr->hash_code == h && equal.operator()(ptr->value.first, key))return ptr;
                 else ptr = ptr->next;
             }
             return nullptr;
         }
 
-        void insert_data(node *now) const noexcept {
-            unsigned int index = hash.operator()(now->value->first) % array_size;
-            node *p = data[index];
-            while (p->next != nullptr) {
-                if (equal.operator()(p->next->value->first, now->value->first))break;
-                p = p->next;
-            }
-            p->next = now;
+        node *find_(const Key &key) const {
+            return find_(key, hash.operator()(key));
         }
 
     public:
 
         linked_hashmap() {
-            data = new node *[array_size];
-            for (int i = 0; i < array_size; ++i)data[i] = new node;
-            head = new node;
-            rear = head;
-            //现在他们作为头节点，所有的东西都是空的
+            data = new node *[array_size]();
+            head = rear = nullptr;
+        }
+
+        /**
+         * construct from the value_types in [first, last), see insert(first, last).
+         */
+        template<class InputIt>
+        linked_hashmap(InputIt first, InputIt last) {
+            data = new node *[array_size]();
+            head = rear = nullptr;
+            insert(first, last);
         }
 
         linked_hashmap(const linked_hashmap &other) {
             scale = other.scale;
-            data = new node *[array_size];
-            for (int i = 0; i < array_size; ++i)data[i] = new node;
-            node *ptr = other.head->after;
-            head = new node;
-            rear = head;
-            node *now;
-            rear = head;
-            while (ptr != nullptr) {
-                now = new node(*(ptr->value));
-                rear->after = now;
-                now->before = rear;
-                insert_data(now);
-                rear = now;
-                ptr = ptr->after;
+            max_load = other.max_load;
+            array_size = bucket_count_for((size_t) (other.scale / max_load) + 1);
+            data = new node *[array_size]();
+            head = rear = nullptr;
+            if (other.scale > 0)new_block(other.scale);//一次分配够所有节点
+            for (node *ptr = other.head; ptr != nullptr; ptr = ptr->after) {
+                node *now = new_node(ptr->hash_code, ptr->value);
+                append(now);
+                link(now);
             }
         }
 
         linked_hashmap &operator=(const linked_hashmap &other) {
             if (&other == this)return *this;
             clear();
+            max_load = other.max_load;
+            reserve(other.scale);
             scale = other.scale;
-            node *ptr = other.head->after;
-            node *now;
-            rear = head;
-            while (ptr != nullptr) {
-                now = new node(*(ptr->value));
-                rear->after = now;
-                now->before = rear;
-                insert_data(now);
-                rear = now;
-                ptr = ptr->after;
+            if (other.scale > 0)new_block(other.scale);
+            for (node *ptr = other.head; ptr != nullptr; ptr = ptr->after) {
+                node *now = new_node(ptr->hash_code, ptr->value);
+                append(now);
+                link(now);
             }
             return *this;
         }
 
         ~linked_hashmap() {
-            clear();//clear之后数组还在，只是数组全部都清空了
-            for (int i = 0; i < array_size; ++i)delete data[i];
+            //桶数组马上就要释放，不用清空；值不用析构的时候连链表都不用走
+            if (!std::is_trivially_destructible<value_type>::value)
+                for (node *ptr = head, *next; ptr != nullptr; ptr = next) {
+                    next = ptr->after;
+                    ptr->~node();
+                }
+            free_blocks();
+            delete[]old_data;
             delete[]data;
-            delete head;
         }
 
         T &at(const Key &key) {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index]->next;
-            while (ptr != nullptr) {
-                if (equal.operator()(ptr->value->first, key))break;
-                else ptr = ptr->next;
-            }
-            if (ptr != nullptr)return ptr->value->second;
+            migrate(rehash_step);
+            node *ptr = find_(key);
+            if (ptr != nullptr)return ptr->value.second;
             else {
                 index_out_of_bound e;
                 throw e;
@@ -471,46 +859,65 @@ namespace sjtu {
         }
 
         const T &at(const Key &key) const {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index]->next;
-            while (ptr != nullptr) {
-                if (equal.operator()(ptr->value->first, key))break;
-                else ptr = ptr->next;
-            }
-            if (ptr != nullptr)return ptr->value->second;
+            node *ptr = find_(key);
+            if (ptr != nullptr)return ptr->value.second;
             else {
                 index_out_of_bound e;
                 throw e;
             }
         }
 
-        T &operator[](const Key &key) {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index]->next;
-            while (ptr != nullptr) {
-                if (equal.operator()(ptr->value->first, key))break;
-                else ptr = ptr->next;
+        /**
+         * heterogeneous lookup, only when both Hash and Equal declare is_transparent:
+         * key can be anything they accept (e.g. a const char * for a std::string map),
+         * no temporary Key is built.
+         */
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        T &at(const K &key) {
+            migrate(rehash_step);
+            node *ptr = find_(key, hash.operator()(key));
+            if (ptr != nullptr)return ptr->value.second;
+            else {
+                index_out_of_bound e;
+                throw e;
             }
-            if (ptr != nullptr)return ptr->value->second;
+        }
+
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        const T &at(const K &key) const {
+            node *ptr = find_(key, hash.operator()(key));
+            if (ptr != nullptr)return ptr->value.second;
             else {
-                T t;
-                pair<node *, bool> tmp = insert_({key, t});
-                scale++;
-                return tmp.first->value->second;
+                index_out_of_bound e;
+                throw e;
             }
         }
 
+        T &operator[](const Key &key) {
+            return try_emplace_(key).first->value.second;
+        }
+
+        T &operator[](Key &&key) {
+            return try_emplace_(std::move(key)).first->value.second;
+        }
+
+        /**
+         * heterogeneous version, a Key is constructed from key only when it has to be inserted.
+         */
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        T &operator[](const K &key) {
+            return try_emplace_hashed_(hash.operator()(key), key).first->value.second;
+        }
+
         /**
          * behave like at() throw index_out_of_bound if such key does not exist.
          */
         const T &operator[](const Key &key) const {
-            unsigned int index = hash.operator()(key) % array_size;
-            node *ptr = data[index]->next;
-            while (ptr != nullptr) {
-                if (equal.operator()(ptr->value->first, key))break;
-                else ptr = ptr->next;
-            }
-            if (ptr != nullptr)return ptr->value->second;
+            node *ptr = find_(key);
+            if (ptr != nullptr)return ptr->value.second;
             else {
                 index_out_of_bound e;
                 throw e;
@@ -521,12 +928,12 @@ namespace sjtu {
          * return a iterator to the beginning
          */
         iterator begin() {
-            iterator tmp(head->after, this);
+            iterator tmp(head, this);
             return tmp;
         }
 
         const_iterator cbegin() const {
-            const_iterator tmp(head->after, this);
+            const_iterator tmp(head, this);
             return tmp;
         }
 
@@ -555,23 +962,122 @@ namespace sjtu {
             return scale;
         }
 
+        size_t bucket_count() const {
+            return array_size;
+        }
+
+        /**
+         * the average number of elements per bucket.
+         */
+        float load_factor() const {
+            return (float) scale / array_size;
+        }
+
+#ifdef SJTU_LINKEDHASHMAP_STATS
+        /**
+         * collect the statistics described at linked_hashmap_stats.
+         * walks every bucket, so it takes O(bucket_count() + size()).
+         */
+        linked_hashmap_stats stats() const {
+            linked_hashmap_stats s;
+            s.size = scale;
+            s.bucket_count = array_size;
+            s.load_factor = load_factor();
+            for (int i = 0; i < linked_hashmap_stats::histogram_size; ++i)s.chain_histogram[i] = 0;
+            s.max_chain = 0;
+            //rehash没搬完的时候，旧表里还没搬的桶也算
+            for (int t = 0; t < 2; ++t) {
+                node **table = t == 0 ? data : old_data;
+                unsigned int begin = t == 0 ? 0 : rehash_index, end = t == 0 ? array_size : old_size;
+                if (table == nullptr)continue;
+                for (unsigned int i = begin; i < end; ++i) {
+                    size_t length = 0;
+                    for (node *ptr = table[i]; ptr != nullptr; ptr = ptr->next)++length;
+                    if (length > s.max_chain)s.max_chain = length;
+                    ++s.chain_histogram[length < linked_hashmap_stats::histogram_size ? length :
+                                        linked_hashmap_stats::histogram_size - 1];
+                }
+            }
+            s.lookups = counters.lookups.load(std::memory_order_relaxed);
+            s.probes = counters.probes.load(std::memory_order_relaxed);
+            s.average_probes = s.lookups == 0 ? 0 : (double) s.probes / s.lookups;
+            s.rehashes = counters.rehashes;
+            s.rehash_seconds = counters.rehash_nanoseconds / 1e9;
+            s.bytes = sizeof(*this) + sizeof(node *) * (array_size + (old_data == nullptr ? 0 : old_size)) +
+                      counters.node_bytes;
+            s.bytes_per_entry = scale == 0 ? 0 : (double) s.bytes / scale;
+            return s;
+        }
+
+        /**
+         * zero the lookup, probe and rehash counters.
+         */
+        void reset_stats() {
+            counters.lookups.store(0, std::memory_order_relaxed);
+            counters.probes.store(0, std::memory_order_relaxed);
+            counters.rehashes = counters.rehash_nanoseconds = 0;
+            counters.migrate_steps = 0;
+        }
+#endif
+
+        float max_load_factor() const {
+            return max_load;
+        }
+
+        /**
+         * the table grows when load_factor() goes above ml, and shrinks when it falls below ml / 4.
+         * throw runtime_error unless ml is positive and finite.
+         */
+        void max_load_factor(float ml) {
+            if (!valid_max_load(ml)) {
+                runtime_error e;
+                throw e;
+            }
+            max_load = ml;
+            if (scale > array_size * max_load)rehash(0);
+        }
+
+        /**
+         * set the number of buckets to at least count (and enough for the current elements).
+         */
+        void rehash(size_t count) {
+            size_t need = (size_t) (scale / max_load) + 1;
+            if (count < need)count = need;
+            unsigned int new_size = bucket_count_for(count);
+            if (new_size != array_size)rebuild(new_size);
+        }
+
+        /**
+         * make room for count elements without rehashing.
+         */
+        void reserve(size_t count) {
+            size_t need = (size_t) (count / max_load) + 1;
+            if (need > array_size)rebuild(bucket_count_for(need));
+        }
+
         /**
          * clears the contents
          */
         void clear() {
-            //把每个数组后面拖着的链清空
-            for (int i = 0; i < array_size; ++i) {
-                node *ptr = data[i]->next;
-                data[i]->next = nullptr;
+            //元素比桶少很多的时候只清用到的桶，否则整个桶数组memset
+            //正在rehash的时候节点可能在旧表里，也直接memset
+            bool sparse = old_data == nullptr && scale < array_size / 8;
+            //值不用析构、桶也不用一个个清的时候，连链表都不用走
+            if (sparse || !std::is_trivially_destructible<value_type>::value) {
+                node *ptr = head;
                 while (ptr != nullptr) {
-                    node *del = ptr;
-                    ptr = ptr->next;
-                    delete del;
+                    node *next = ptr->after;
+                    if (sparse)data[index_of(ptr->hash_code, array_size)] = nullptr;
+                    ptr->~node();
+                    ptr = next;
                 }
             }
+            if (!sparse)memset((void *) data, 0, sizeof(node *) * array_size);
+            free_blocks();
+            delete[]old_data;
+            old_data = nullptr;
             scale = 0;
-            head->after = nullptr;
-            rear = head;
+            head = rear = nullptr;
         }
 
         /**
@@ -583,22 +1089,182 @@ namespace sjtu {
         pair<iterator, bool> insert(const value_type &v) {
             pair<node *, bool> tmp = insert_(v);
             iterator tmpi(tmp.first, this);
-            if (tmp.second)scale++;
             return {tmpi, tmp.second};
         }
 
+        pair<iterator, bool> insert(value_type &&v) {
+            migrate(rehash_step);
+            size_t h = hash.operator()(v.first);
+            node **link;
+            node *found = locate(v.first, h, link);
+            if (found != nullptr)return {iterator(found, this), false};
+            return {iterator(attach(link, new_node(h, std::move(v))), this), true};
+        }
+
+        /**
+         * construct a value_type from args and insert it if its key is not in the map yet.
+         * the element is built once, right in its node; if the key exists it is thrown away.
+         */
+        template<class... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            migrate(rehash_step);
+            node *now = new_node(0, std::forward<Args>(args)...);
+            size_t h = now->hash_code = hash.operator()(now->value.first);
+            node **link;
+            node *found = locate(now->value.first, h, link);
+            if (found != nullptr) {
+                release(now);
+                return {iterator(found, this), false};
+            }
+            return {iterator(attach(link, now), this), true};
+        }
+
+        /**
+         * if key is not in the map, insert it with a T constructed in place from args;
+         *   otherwise do nothing (args are not touched).
+         */
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const Key &key, Args &&... args) {
+            pair<node *, bool> tmp = try_emplace_(key, std::forward<Args>(args)...);
+            return {iterator(tmp.first, this), tmp.second};
+        }
+
+        template<class... Args>
+        pair<iterator, bool> try_emplace(Key &&key, Args &&... args) {
+            pair<node *, bool> tmp = try_emplace_(std::move(key), std::forward<Args>(args)...);
+            return {iterator(tmp.first, this), tmp.second};
+        }
+
+        /**
+         * try_emplace with a hash computed beforehand, hash_value must equal hash_function()(key),
+         *   see find(const Key &, size_t).
+         */
+        template<class... Args>
+        pair<iterator, bool> try_emplace_hashed(size_t hash_value, const Key &key, Args &&... args) {
+            pair<node *, bool> tmp = try_emplace_hashed_(hash_value, key, std::forward<Args>(args)...);
+            return {iterator(tmp.first, this), tmp.second};
+        }
+
+        /**
+         * assign obj to the value of key, or insert it if key is not in the map.
+         * the second of the result is true if it was inserted.
+         */
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+            pair<node *, bool> tmp = try_emplace_(key, std::forward<M>(obj));
+            if (!tmp.second)tmp.first->value.second = std::forward<M>(obj);
+            return {iterator(tmp.first, this), tmp.second};
+        }
+
+        template<class M>
+        pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+            pair<node *, bool> tmp = try_emplace_(std::move(key), std::forward<M>(obj));
+            if (!tmp.second)tmp.first->value.second = std::forward<M>(obj);
+            return {iterator(tmp.first, this), tmp.second};
+        }
+
+        /**
+         * insert the value_types in [first, last), keys already in the map (or repeated) are skipped.
+         * for forward iterators the table and the nodes are sized for the whole range before inserting.
+         */
+        template<class InputIt>
+        void insert(InputIt first, InputIt last) {
+            prepare_range(first, last);
+            for (; first != last; ++first)insert_(*first);
+        }
+
+        /**
+         * like insert(first, last), but the caller guarantees that no key in [first, last)
+         *   is repeated or already in the map, so the chains are not searched for it.
+         * breaking that promise leaves duplicate keys in the map.
+         */
+        template<class InputIt>
+        void insert_unique(InputIt first, InputIt last) {
+            prepare_range(first, last);
+            for (; first != last; ++first) {
+                migrate(rehash_step);
+                const value_type &v = *first;
+                size_t h = hash.operator()(v.first);
+                node *now = new_node(h, v);
+                node *&bucket = bucket_at(h);
+                now->next = bucket;
+                bucket = now;
+                append(now);
+                scale++;
+                grow();
+            }
+        }
+
         /**
          * erase the element at pos.
          *
          * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
          */
         void erase(iterator pos) {
-            if (this != pos.me || pos.ptr == nullptr || pos.ptr == head) {
+            if (this != pos.me || pos.ptr == nullptr) {
                 runtime_error e;
                 throw e;
             }
-            scale--;
-            remove_(pos.ptr->value->first);
+            remove_(pos.ptr);
+            shrink();
+        }
+
+        /**
+         * erase the elements in [first, last) (in insertion order) and return last.
+         * the nodes are unlinked directly, no key is hashed or compared.
+         *
+         * throw if [first, last) is not a range of this map.
+         */
+        iterator erase(iterator first, iterator last) {
+            if (this != first.me || this != last.me) {
+                runtime_error e;
+                throw e;
+            }
+            //先确认从first能走到last，再动手删
+            node *ptr = first.ptr;
+            while (ptr != last.ptr) {
+                if (ptr == nullptr) {
+                    runtime_error e;
+                    throw e;
+                }
+                ptr = ptr->after;
+            }
+            for (ptr = first.ptr; ptr != last.ptr;) {
+                node *next = ptr->after;
+                remove_(ptr);
+                ptr = next;
+            }
+            shrink();
+            return last;
+        }
+
+        /**
+         * erase the oldest element (begin()).
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop_front() {
+            if (head == nullptr) {
+                container_is_empty e;
+                throw e;
+            }
+            remove_(head);
+            shrink();
+        }
+
+        /**
+         * move the element at pos to the end of the iteration order in O(1),
+         *   as if it had just been inserted. iterators stay valid.
+         *
+         * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
+         */
+        void move_to_back(iterator pos) {
+            if (this != pos.me || pos.ptr == nullptr) {
+                runtime_error e;
+                throw e;
+            }
+            if (pos.ptr == rear)return;
+            unlink(pos.ptr);
+            append(pos.ptr);
         }
 
         /**
@@ -613,6 +1279,14 @@ namespace sjtu {
             else return 1;
         }
 
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        size_t count(const K &key) const {
+            node *tmp = find_(key, hash.operator()(key));
+            if (tmp == nullptr)return 0;
+            else return 1;
+        }
+
         /**
          * Finds an element with key equivalent to key.
          * key value of the element to search for.
@@ -620,6 +1294,7 @@ namespace sjtu {
          *   If no such element is found, past-the-end (see end()) iterator is returned.
          */
         iterator find(const Key &key) {
+            migrate(rehash_step);
             node *tmp = find_(key);
             if (tmp == nullptr)return end();
             else {
@@ -636,24 +1311,188 @@ namespace sjtu {
                 return tmpi;
             }
         }
+
+        /**
+         * find with a hash computed beforehand, hash_value must equal hash_function()(key).
+         * lets one hash serve lookups in several maps with the same Hash.
+         */
+        iterator find(const Key &key, size_t hash_value) {
+            migrate(rehash_step);
+            node *tmp = find_(key, hash_value);
+            if (tmp == nullptr)return end();
+            else {
+                iterator tmpi(tmp, this);
+                return tmpi;
+            }
+        }
+
+        const_iterator find(const Key &key, size_t hash_value) const {
+            node *tmp = find_(key, hash_value);
+            if (tmp == nullptr)return cend();
+            else {
+                const_iterator tmpi(tmp, this);
+                return tmpi;
+            }
+        }
+
+        /**
+         * heterogeneous find, see at(const K &).
+         */
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        iterator find(const K &key) {
+            return find(key, hash.operator()(key));
+        }
+
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        const_iterator find(const K &key) const {
+            return find(key, hash.operator()(key));
+        }
+
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        iterator find(const K &key, size_t hash_value) {
+            migrate(rehash_step);
+            node *tmp = find_(key, hash_value);
+            if (tmp == nullptr)return end();
+            else {
+                iterator tmpi(tmp, this);
+                return tmpi;
+            }
+        }
+
+        template<class K, class H = Hash, class E = Equal,
+                class = typename H::is_transparent, class = typename E::is_transparent>
+        const_iterator find(const K &key, size_t hash_value) const {
+            node *tmp = find_(key, hash_value);
+            if (tmp == nullptr)return cend();
+            else {
+                const_iterator tmpi(tmp, this);
+                return tmpi;
+            }
+        }
+
+        Hash hash_function() const {
+            return hash;
+        }
+
+        /**
+         * write the map to file in the linked_hashmap_image format (see linked_hashmap_image_header):
+         *   the elements in insertion order, their hash values, and the bucket layout.
+         * Key and T must be trivially copyable.
+         * throw runtime_error if writing fails.
+         */
+        void save(FILE *file) const {
+            static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<T>::value,
+                          "linked_hashmap::save needs trivially copyable Key and T");
+            typedef linked_hashmap_image_entry<Key, T> entry;
+            linked_hashmap_image_header header;
+            memset((void *) &header, 0, sizeof(header));
+            memcpy(header.magic, linked_hashmap_image_header::expected_magic(), sizeof(header.magic));
+            header.key_size = sizeof(Key);
+            header.value_size = sizeof(T);
+            header.entry_size = sizeof(entry);
+            header.count = scale;
+            header.bucket_count = array_size;
+            header.max_load = max_load;
+            char padding[linked_hashmap_image_header::entries_offset] = {};
+            bool ok = fwrite((const void *) &header, sizeof(header), 1, file) == 1;
+            ok = ok && fwrite(padding, linked_hashmap_image_header::entries_offset - sizeof(header), 1, file) == 1;
+            //按插入顺序写，链表在写的同时拼出来：新的一个挂在桶的最前面
+            unsigned int *buckets = new unsigned int[array_size];
+            for (unsigned int i = 0; i < array_size; ++i)buckets[i] = linked_hashmap_image_header::no_entry;
+            alignas(entry) char buffer[sizeof(entry)];
+            entry *e = (entry *) buffer;
+            unsigned int index = 0;
+            for (node *ptr = head; ok && ptr != nullptr; ptr = ptr->after, ++index) {
+                memset(buffer, 0, sizeof(buffer));
+                memcpy((void *) &e->first, (const void *) &ptr->value.first, sizeof(Key));
+                memcpy((void *) &e->second, (const void *) &ptr->value.second, sizeof(T));
+                e->hash_code = ptr->hash_code;
+                unsigned int &bucket = buckets[ptr->hash_code % array_size];
+                e->next = bucket;
+                bucket = index;
+                ok = fwrite(buffer, sizeof(entry), 1, file) == 1;
+            }
+            ok = ok && fwrite((const void *) buckets, sizeof(unsigned int), array_size, file) == array_size;
+            delete[]buckets;
+            if (!ok) {
+                runtime_error e;
+                throw e;
+            }
+        }
+
+        /**
+         * replace the contents with a map written by save(), keeping its insertion order and bucket count.
+         * the whole snapshot is consumed, so several of them written one after another can be loaded in turn.
+         * the stored hash values are reused, so it has to be loaded with the same Hash.
+         * throw runtime_error if the file is not such a snapshot or reading fails (the map is left empty).
+         */
+        void load(FILE *file) {
+            static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<T>::value,
+                          "linked_hashmap::load needs trivially copyable Key and T");
+            typedef linked_hashmap_image_entry<Key, T> entry;
+            linked_hashmap_image_header header;
+            char padding[linked_hashmap_image_header::entries_offset];
+            if (fread((void *) &header, sizeof(header), 1, file) != 1 ||
+                fread(padding, linked_hashmap_image_header::entries_offset - sizeof(header), 1, file) != 1 ||
+                memcmp(header.magic, linked_hashmap_image_header::expected_magic(), sizeof(header.magic)) != 0 ||
+                header.key_size != sizeof(Key) || header.value_size != sizeof(T) || header.entry_size != sizeof(entry) ||
+                !valid_max_load(header.max_load) || header.count >= linked_hashmap_image_header::no_entry ||
+                header.bucket_count == 0 || header.bucket_count > 0xffffffffull) {
+                clear();
+                runtime_error e;
+                throw e;
+            }
+            clear();
+            max_load = header.max_load;
+            //存下来的桶数在这种Hash下不一定合法（比如要2的幂），取最接近的合法值
+            unsigned int saved_buckets = bucket_count_for(header.bucket_count);
+            if (saved_buckets != array_size)rebuild(saved_buckets);
+            reserve(header.count);
+            reserve_nodes(header.count);
+            //一次读一批，直接按存下来的哈希值挂到桶上，不用再算哈希，也不用查重
+            const size_t batch = 4096;
+            entry *buffer = (entry *) malloc(sizeof(entry) * batch);
+            unsigned long long left = header.count;
+            while (left > 0) {
+                size_t n = left < batch ? (size_t) left : batch;
+                if (fread((void *) buffer, sizeof(entry), n, file) != n) {
+                    free((void *) buffer);
+                    clear();
+                    runtime_error e;
+                    throw e;
+                }
+                for (size_t i = 0; i < n; ++i) {
+                    node *now = new_node((size_t) buffer[i].hash_code, buffer[i].first, buffer[i].second);
+                    node *&bucket = data[index_of(now->hash_code, array_size)];
+                    now->next = bucket;
+                    bucket = now;
+                    append(now);
+                }
+                scale += n;
+                left -= n;
+            }
+            free((void *) buffer);
+            //桶数组用不着（链在上面已经按哈希值重新挂好了），但要读掉，顺便检查一下
+            unsigned int indices[1024];
+            left = header.bucket_count;
+            while (left > 0) {
+                size_t n = left < 1024 ? (size_t) left : 1024;
+                bool ok = fread((void *) indices, sizeof(unsigned int), n, file) == n;
+                for (size_t i = 0; ok && i < n; ++i)
+                    ok = indices[i] < header.count || indices[i] == linked_hashmap_image_header::no_entry;
+                if (!ok) {
+                    clear();
+                    runtime_error e;
+                    throw e;
+                }
+                left -= n;
+            }
+        }
     };
 
 }
 
-//void Double_Space() {
-//    node **tmp = data;//先把数组找个地方放好
-//    data = new node *[array_size * 2];
-//    for (int i = 0; i < array_size; ++i) {
-//        data[i] = new node;
-//        //现在作为头节点都是空的
-//        data[i]->next = tmp->next;
-//        tmp->next = nullptr;
-//        //把原来的链放到这里
-//        delete tmp[i];
-//    }
-//    for (int i = array_size; i < array_size * 2; ++i) {
-//        data[i] = new node;
-//    }
-//    array_size *= 2;
-//}
 #endif
@@ -0,0 +1,158 @@
+//把linked_hashmap::save()写出的文件mmap进来，直接在文件上查找，不用一个个建节点
+#ifndef SJTU_LINKEDHASHMAP_IMAGE_HPP
+#define SJTU_LINKEDHASHMAP_IMAGE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "linked_hashmap.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a read-only linked_hashmap served straight from a file written by linked_hashmap::save().
+ * opening maps the file and checks its header and every bucket / chain index, nothing is copied or allocated;
+ *   a truncated or corrupted file is rejected there instead of being read out of bounds later.
+ * iteration (begin() / end()) goes through the entries in insertion order.
+ * Key, T and Hash have to be the ones the file was saved with.
+ */
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class linked_hashmap_image {
+    public:
+        typedef linked_hashmap_image_entry<Key, T> value_type;
+
+    private:
+        typedef linked_hashmap_image_header header_type;
+
+        void *memory;
+        size_t length;
+        const header_type *header;
+        const value_type *entries;
+        const unsigned int *buckets;
+        Hash hash;
+        Equal equal;
+
+        const value_type *find_(const Key &key) const {
+            if (header->bucket_count == 0)return nullptr;
+            size_t h = hash.operator()(key);
+            unsigned int i = buckets[h % header->bucket_count];
+            while (i != header_type::no_entry) {
+                const value_type &e = entries[i];
+                if (e.hash_code == h && equal.operator()(e.first, key))return &e;
+                i = e.next;
+            }
+            return nullptr;
+        }
+
+        //桶和next都要指向已有的entry；save()写的next总是指向更早的entry，这样链上不会有环
+        bool valid_indices() const {
+            const unsigned int no_entry = header_type::no_entry;
+            for (unsigned long long i = 0; i < header->bucket_count; ++i)
+                if (buckets[i] != no_entry && buckets[i] >= header->count)return false;
+            for (unsigned long long i = 0; i < header->count; ++i)
+                if (entries[i].next != no_entry && entries[i].next >= i)return false;
+            return true;
+        }
+
+        void fail(int fd) {
+            if (memory != nullptr)munmap(memory, length);
+            if (fd >= 0)close(fd);
+            runtime_error e;
+            throw e;
+        }
+
+    public:
+        /**
+         * map the file at path.
+         * throw runtime_error if it cannot be mapped or is not a snapshot of this kind of map.
+         */
+        explicit linked_hashmap_image(const char *path) {
+            memory = nullptr;
+            length = 0;
+            int fd = open(path, O_RDONLY);
+            if (fd < 0)fail(fd);
+            struct stat st;
+            if (fstat(fd, &st) != 0 || (size_t) st.st_size < header_type::entries_offset)fail(fd);
+            length = (size_t) st.st_size;
+            memory = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (memory == MAP_FAILED) {
+                memory = nullptr;
+                fail(fd);
+            }
+            close(fd);//映射建好以后文件描述符就用不着了
+            header = (const header_type *) memory;
+            //先限制个数再算长度，坏掉的个数乘出来可能溢出
+            if (memcmp(header->magic, header_type::expected_magic(), sizeof(header->magic)) != 0 ||
+                header->key_size != sizeof(Key) || header->value_size != sizeof(T) ||
+                header->entry_size != sizeof(value_type) ||
+                header->count > length / sizeof(value_type) || header->bucket_count > length / sizeof(unsigned int) ||
+                length != header_type::entries_offset + header->count * sizeof(value_type) +
+                          header->bucket_count * sizeof(unsigned int))
+                fail(-1);
+            entries = (const value_type *) ((const char *) memory + header_type::entries_offset);
+            buckets = (const unsigned int *) (entries + header->count);
+            if (!valid_indices())fail(-1);
+        }
+
+        linked_hashmap_image(const linked_hashmap_image &other) = delete;
+
+        linked_hashmap_image &operator=(const linked_hashmap_image &other) = delete;
+
+        ~linked_hashmap_image() {
+            munmap(memory, length);
+        }
+
+        /**
+         * return a pointer to the value of key, or nullptr if there is no such key.
+         */
+        const T *find(const Key &key) const {
+            const value_type *e = find_(key);
+            return e == nullptr ? nullptr : &e->second;
+        }
+
+        /**
+         * throw index_out_of_bound if such key does not exist.
+         */
+        const T &at(const Key &key) const {
+            const value_type *e = find_(key);
+            if (e == nullptr) {
+                index_out_of_bound ex;
+                throw ex;
+            }
+            return e->second;
+        }
+
+        size_t count(const Key &key) const {
+            return find_(key) == nullptr ? 0 : 1;
+        }
+
+        size_t size() const {
+            return header->count;
+        }
+
+        bool empty() const {
+            return header->count == 0;
+        }
+
+        const value_type *begin() const {
+            return entries;
+        }
+
+        const value_type *end() const {
+            return entries + header->count;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,216 @@
+//用linked_hashmap的插入顺序做缓存：链表头是最久没用过的，尾是最近用过的
+#ifndef SJTU_LRU_CACHE_HPP
+#define SJTU_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include "linked_hashmap.hpp"
+
+namespace sjtu {
+
+/**
+ * a least-recently-used cache holding at most capacity entries.
+ * a hit moves the entry to the back of the map's order list in O(1),
+ * and when a new key does not fit, the entry at the front (the least recently used) is evicted.
+ */
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class lru_cache {
+    private:
+        typedef linked_hashmap<Key, T, Hash, Equal> map_type;
+
+        map_type map;
+        size_t capacity_;
+        size_t hits_ = 0;
+        size_t misses_ = 0;
+
+    public:
+        explicit lru_cache(size_t capacity) {
+            capacity_ = capacity < 1 ? 1 : capacity;
+            map.reserve(capacity_);
+        }
+
+        /**
+         * look key up and mark it as just used.
+         * return a pointer to the cached value, or nullptr on a miss.
+         * the pointer stays valid until the entry is evicted or erased.
+         */
+        T *get(const Key &key) {
+            typename map_type::iterator it = map.find(key);
+            if (it == map.end()) {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            map.move_to_back(it);
+            return &it->second;
+        }
+
+        /**
+         * insert or overwrite key, it becomes the most recently used entry.
+         */
+        void put(const Key &key, const T &value) {
+            typename map_type::iterator it = map.find(key);
+            if (it != map.end()) {
+                it->second = value;
+                map.move_to_back(it);
+                return;
+            }
+            if (map.size() == capacity_)map.erase(map.begin());
+            map.insert({key, value});
+        }
+
+        /**
+         * whether key is cached, without touching its position or the statistics.
+         */
+        bool contains(const Key &key) const {
+            return map.count(key) != 0;
+        }
+
+        void erase(const Key &key) {
+            typename map_type::iterator it = map.find(key);
+            if (it != map.end())map.erase(it);
+        }
+
+        void clear() {
+            map.clear();
+        }
+
+        size_t size() const {
+            return map.size();
+        }
+
+        size_t capacity() const {
+            return capacity_;
+        }
+
+        size_t hits() const {
+            return hits_;
+        }
+
+        size_t misses() const {
+            return misses_;
+        }
+    };
+
+/**
+ * segmented LRU: new keys enter a probation segment, a second hit promotes them to a protected segment.
+ * entries pushed out of the protected segment go back to the probation segment instead of being evicted,
+ * so a long scan of keys used once only churns the probation segment and leaves the hot set alone.
+ * the protected segment takes protected_ratio of the capacity.
+ */
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class slru_cache {
+    private:
+        typedef linked_hashmap<Key, T, Hash, Equal> map_type;
+
+        map_type probation;
+        map_type protect;
+        size_t probation_capacity;
+        size_t protected_capacity;
+        size_t hits_ = 0;
+        size_t misses_ = 0;
+
+        //放到试用段的最后，试用段满了就淘汰最前面的
+        void admit(const Key &key, const T &value) {
+            if (probation.size() == probation_capacity)probation.erase(probation.begin());
+            probation.insert({key, value});
+        }
+
+    public:
+        explicit slru_cache(size_t capacity, float protected_ratio = 0.8f) {
+            if (capacity < 2)capacity = 2;
+            protected_capacity = (size_t) (capacity * protected_ratio);
+            if (protected_capacity < 1)protected_capacity = 1;
+            if (protected_capacity > capacity - 1)protected_capacity = capacity - 1;
+            probation_capacity = capacity - protected_capacity;
+            probation.reserve(probation_capacity);
+            protect.reserve(protected_capacity);
+        }
+
+        /**
+         * look key up and mark it as just used, a hit in the probation segment promotes the entry.
+         * return a pointer to the cached value, or nullptr on a miss.
+         * the pointer is only valid until the next call on the cache.
+         */
+        T *get(const Key &key) {
+            typename map_type::iterator it = protect.find(key);
+            if (it != protect.end()) {
+                ++hits_;
+                protect.move_to_back(it);
+                return &it->second;
+            }
+            it = probation.find(key);
+            if (it == probation.end()) {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            //升到保护段，保护段满了就把最前面的降回试用段
+            if (protect.size() == protected_capacity) {
+                typename map_type::iterator demoted = protect.begin();
+                probation.insert({demoted->first, demoted->second});
+                protect.erase(demoted);
+            }
+            typename map_type::iterator promoted = protect.insert(*it).first;
+            probation.erase(it);
+            return &promoted->second;
+        }
+
+        /**
+         * insert or overwrite key. a new key enters the probation segment.
+         */
+        void put(const Key &key, const T &value) {
+            typename map_type::iterator it = protect.find(key);
+            if (it != protect.end()) {
+                it->second = value;
+                protect.move_to_back(it);
+                return;
+            }
+            it = probation.find(key);
+            if (it != probation.end()) {
+                it->second = value;
+                probation.move_to_back(it);
+                return;
+            }
+            admit(key, value);
+        }
+
+        bool contains(const Key &key) const {
+            return protect.count(key) != 0 || probation.count(key) != 0;
+        }
+
+        void clear() {
+            probation.clear();
+            protect.clear();
+        }
+
+        size_t size() const {
+            return probation.size() + protect.size();
+        }
+
+        size_t capacity() const {
+            return probation_capacity + protected_capacity;
+        }
+
+        size_t hits() const {
+            return hits_;
+        }
+
+        size_t misses() const {
+            return misses_;
+        }
+    };
+
+}
+
+#endif
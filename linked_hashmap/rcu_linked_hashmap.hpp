@@ -0,0 +1,343 @@
+//读多写少的linked_hashmap：读不加锁，写串行，删掉的节点等所有读者离开之后再释放
+#ifndef SJTU_RCU_LINKEDHASHMAP_HPP
+#define SJTU_RCU_LINKEDHASHMAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "utility.hpp"
+
+namespace sjtu {
+
+/**
+ * a hash map for tables that are read all the time and written rarely.
+ *
+ * find() / contains() take no lock and never wait: buckets and chains are atomic pointers,
+ *   and a published node is never modified (assign() publishes a new node in place of the old one).
+ * writers are serialized by a mutex. nodes (and old bucket arrays) taken out of the map are only freed
+ *   after every reader that might still see them has left, which is tracked with epochs:
+ *   each reader announces itself in a per-thread slot under the current epoch's parity,
+ *   and a writer flips the epoch and waits for the readers of the old parity to drain.
+ * iteration in insertion order goes through the writers' lock.
+ */
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class rcu_linked_hashmap {
+    public:
+        typedef pair<const Key, T> value_type;
+
+    private:
+        struct node {
+            value_type value;
+            size_t hash_code;
+            std::atomic<node *> next;
+            node *before = nullptr;//插入顺序只有写者用，不需要原子
+            node *after = nullptr;//节点摘下来以后after用来串待释放的链表
+
+            node(const value_type &v, size_t h) : value(v), hash_code(h), next(nullptr) {}
+        };
+
+        //桶数是2的幂，哈希值乘黄金比例取高位
+        struct table {
+            std::atomic<node *> *buckets;
+            size_t size;
+            unsigned int shift;
+
+            explicit table(unsigned int bits) {
+                size = (size_t) 1 << bits;
+                shift = 64 - bits;
+                buckets = new std::atomic<node *>[size];
+                for (size_t i = 0; i < size; ++i)buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            ~table() {
+                delete[]buckets;
+            }
+
+            std::atomic<node *> &bucket(size_t h) const {
+                return buckets[(size_t) (((unsigned long long) h * 0x9E3779B97F4A7C15ull) >> shift)];
+            }
+        };
+
+        //每个槽记录正在读的读者个数，按纪元的奇偶分开计数
+        struct reader_slot {
+            std::atomic<unsigned int> active[2];
+            char padding[64];//不同的槽不要落在同一条cache line上
+        };
+
+        static const int slot_count = 64;
+        static const size_t retire_limit = 128;
+
+        std::atomic<table *> current;
+        std::atomic<unsigned long long> epoch;
+        reader_slot *slots;
+        std::atomic<size_t> scale;
+
+        std::mutex write_lock;
+        node *head = nullptr;
+        node *rear = nullptr;
+        node *retired = nullptr;//已经摘下来、还没释放的节点，用after串起来
+        size_t retired_count = 0;
+
+        Hash hash;
+        Equal equal;
+
+        //线程第一次读的时候分到一个槽，线程比槽多的时候几个线程共用一个槽，只是慢一点
+        static unsigned int thread_slot() {
+            static std::atomic<unsigned int> next_slot(0);
+            static thread_local unsigned int slot = next_slot++ % slot_count;
+            return slot;
+        }
+
+        //读者进出：在自己的槽里按当前纪元的奇偶计数，进来之后纪元变了就重来
+        class reader_guard {
+            std::atomic<unsigned int> *counter;
+
+        public:
+            explicit reader_guard(const rcu_linked_hashmap *map) {
+                reader_slot &s = map->slots[thread_slot()];
+                while (true) {
+                    unsigned long long e = map->epoch.load();
+                    counter = &s.active[e & 1];
+                    counter->fetch_add(1);
+                    if (map->epoch.load() == e)break;
+                    counter->fetch_sub(1);
+                }
+            }
+
+            ~reader_guard() {
+                counter->fetch_sub(1, std::memory_order_release);
+            }
+        };
+
+        //翻转纪元，等旧纪元的读者都离开；调用之前摘下来的东西之后就没人能看到了
+        void synchronize() {
+            unsigned long long e = epoch.load();
+            epoch.store(e + 1);
+            for (int i = 0; i < slot_count; ++i)
+                while (slots[i].active[e & 1].load() != 0)std::this_thread::yield();
+        }
+
+        void free_retired() {
+            while (retired != nullptr) {
+                node *del = retired;
+                retired = retired->after;
+                delete del;
+            }
+            retired_count = 0;
+        }
+
+        //节点已经从桶和插入顺序里摘下来了，攒够一批再一起等读者、一起释放
+        void retire(node *del) {
+            del->after = retired;
+            retired = del;
+            if (++retired_count >= retire_limit) {
+                synchronize();
+                free_retired();
+            }
+        }
+
+        void append(node *now) {
+            if (rear == nullptr)head = now;
+            else {
+                rear->after = now;
+                now->before = rear;
+            }
+            rear = now;
+        }
+
+        //用now在插入顺序里顶替old的位置
+        void replace_in_order(node *old, node *now) {
+            now->before = old->before;
+            now->after = old->after;
+            if (old->before)old->before->after = now;
+            else head = now;
+            if (old->after)old->after->before = now;
+            else rear = now;
+        }
+
+        void unlink(node *now) {
+            if (now->before)now->before->after = now->after;
+            else head = now->after;
+            if (now->after)now->after->before = now->before;
+            else rear = now->before;
+        }
+
+        //写者用：返回指向key所在节点的那个指针（桶或者前一个节点的next），没有就指向链尾的nullptr
+        std::atomic<node *> *locate(const Key &key, size_t h) const {
+            std::atomic<node *> *link = &current.load(std::memory_order_relaxed)->bucket(h);
+            node *p;
+            while ((p = link->load(std::memory_order_relaxed)) != nullptr) {
+                if (p->hash_code == h && equal.operator()(p->value.first, key))break;
+                link = &p->next;
+            }
+            return link;
+        }
+
+        //装载因子超过1就把所有节点复制一份挂到两倍大的新表上，再换掉整张表
+        //旧的节点可能还有读者在走，所以不能直接改它们的next
+        void grow() {
+            table *old = current.load(std::memory_order_relaxed);
+            if (scale.load(std::memory_order_relaxed) <= old->size)return;
+            table *t = new table(64 - old->shift + 1);
+            node *old_head = head;
+            head = rear = nullptr;
+            for (node *p = old_head; p != nullptr; p = p->after) {
+                node *now = new node(p->value, p->hash_code);
+                std::atomic<node *> &bucket = t->bucket(now->hash_code);
+                now->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                bucket.store(now, std::memory_order_relaxed);
+                append(now);
+            }
+            current.store(t, std::memory_order_release);
+            synchronize();
+            free_retired();
+            while (old_head != nullptr) {
+                node *del = old_head;
+                old_head = old_head->after;
+                delete del;
+            }
+            delete old;
+        }
+
+    public:
+        rcu_linked_hashmap() : current(new table(4)), epoch(0), scale(0) {
+            slots = new reader_slot[slot_count];
+            for (int i = 0; i < slot_count; ++i) {
+                slots[i].active[0].store(0);
+                slots[i].active[1].store(0);
+            }
+        }
+
+        rcu_linked_hashmap(const rcu_linked_hashmap &other) = delete;
+
+        rcu_linked_hashmap &operator=(const rcu_linked_hashmap &other) = delete;
+
+        /**
+         * no reader may be inside the map when it is destroyed.
+         */
+        ~rcu_linked_hashmap() {
+            free_retired();
+            while (head != nullptr) {
+                node *del = head;
+                head = head->after;
+                delete del;
+            }
+            delete current.load();
+            delete[]slots;
+        }
+
+        /**
+         * copy the value of key into value, without taking any lock.
+         * return false if there is no such key.
+         */
+        bool find(const Key &key, T &value) const {
+            size_t h = hash.operator()(key);
+            reader_guard guard(this);
+            node *p = current.load(std::memory_order_acquire)->bucket(h).load(std::memory_order_acquire);
+            while (p != nullptr) {
+                if (p->hash_code == h && equal.operator()(p->value.first, key)) {
+                    value = p->value.second;
+                    return true;
+                }
+                p = p->next.load(std::memory_order_acquire);
+            }
+            return false;
+        }
+
+        bool contains(const Key &key) const {
+            size_t h = hash.operator()(key);
+            reader_guard guard(this);
+            node *p = current.load(std::memory_order_acquire)->bucket(h).load(std::memory_order_acquire);
+            while (p != nullptr) {
+                if (p->hash_code == h && equal.operator()(p->value.first, key))return true;
+                p = p->next.load(std::memory_order_acquire);
+            }
+            return false;
+        }
+
+        /**
+         * insert key if it is not there yet.
+         * return true if it was inserted, false if the key already existed (its value is left alone).
+         */
+        bool insert(const Key &key, const T &value) {
+            size_t h = hash.operator()(key);
+            std::lock_guard<std::mutex> guard(write_lock);
+            std::atomic<node *> *link = locate(key, h);
+            if (link->load(std::memory_order_relaxed) != nullptr)return false;
+            node *now = new node({key, value}, h);
+            link->store(now, std::memory_order_release);//节点准备好了再挂上去，读者看到的一定是完整的
+            append(now);
+            scale.fetch_add(1, std::memory_order_relaxed);
+            grow();
+            return true;
+        }
+
+        /**
+         * insert key, or give it a new value if it exists (its insertion order does not change).
+         * readers see either the old or the new value, never a half-written one.
+         */
+        void assign(const Key &key, const T &value) {
+            size_t h = hash.operator()(key);
+            std::lock_guard<std::mutex> guard(write_lock);
+            std::atomic<node *> *link = locate(key, h);
+            node *old = link->load(std::memory_order_relaxed);
+            node *now = new node({key, value}, h);
+            if (old == nullptr) {
+                link->store(now, std::memory_order_release);
+                append(now);
+                scale.fetch_add(1, std::memory_order_relaxed);
+                grow();
+                return;
+            }
+            now->next.store(old->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            link->store(now, std::memory_order_release);
+            replace_in_order(old, now);
+            retire(old);
+        }
+
+        /**
+         * return true if key was there and has been erased.
+         */
+        bool erase(const Key &key) {
+            size_t h = hash.operator()(key);
+            std::lock_guard<std::mutex> guard(write_lock);
+            std::atomic<node *> *link = locate(key, h);
+            node *del = link->load(std::memory_order_relaxed);
+            if (del == nullptr)return false;
+            //del->next不改，正停在del上的读者还能接着往后走
+            link->store(del->next.load(std::memory_order_relaxed), std::memory_order_release);
+            unlink(del);
+            scale.fetch_sub(1, std::memory_order_relaxed);
+            retire(del);
+            return true;
+        }
+
+        /**
+         * call f(key, value) on every element in insertion order.
+         * writers are blocked meanwhile (readers are not), f must not write to this map.
+         */
+        template<class F>
+        void for_each(F f) {
+            std::lock_guard<std::mutex> guard(write_lock);
+            for (node *p = head; p != nullptr; p = p->after)f(p->value.first, p->value.second);
+        }
+
+        size_t size() const {
+            return scale.load(std::memory_order_relaxed);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,521 @@
+/**
+ * the open addressing version of linked_hashmap
+ */
+#ifndef SJTU_ROBIN_HOOD_HPP
+#define SJTU_ROBIN_HOOD_HPP
+
+// only for std::equal_to<T> and std::hash<T>
+#include <functional>
+#include <cstddef>
+#include <cstdlib>
+#include "utility.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+    /**
+     * the basic linked_hashmap interface (at, operator[], insert, erase, find, count, clear, iteration in
+     * insertion order), but with an open addressing (robin hood) table instead of separate chaining.
+     * the rest of linked_hashmap's API (reserve, emplace, move_to_back, range erase, heterogeneous lookup,
+     * save/load, ...) only exists in the chained engine, so lru_cache and the other wrappers need linked_hashmap.
+     * a program picks one engine with an alias, see bench/lookup.cpp; both headers can be included together.
+     *
+     * the entries live in a few blocks of doubling size that never move (so, as in linked_hashmap, references
+     * and pointers to elements stay valid until the element is erased), and the insertion order runs through
+     * them as 32-bit indices; the table itself only holds (entry index, hash) pairs.
+     * a lookup probes a few neighbouring slots of the table and then touches one entry.
+     *
+     * Note that insertion order is not affected if a key is re-inserted
+     * into the map.
+     */
+
+    template<
+            class Key,
+            class T,
+            class Hash = std::hash<Key>,
+            class Equal = std::equal_to<Key>
+    >
+    class robin_hood_hashmap {
+    public:
+        typedef pair<const Key, T> value_type;
+
+    private:
+        static const unsigned int npos = 0xffffffffu;
+        static const unsigned int free_mark = 0xfffffffeu;
+
+        //插入顺序的双向链表，用下标串起来；空闲的entry用after串成空闲链表，before是free_mark
+        struct link {
+            unsigned int before;
+            unsigned int after;
+            unsigned int hash;
+        };
+
+        struct slot {
+            unsigned int entry;//npos表示空
+            unsigned int hash;
+        };
+
+    public:
+        class const_iterator;
+
+        class iterator {
+        public:
+            robin_hood_hashmap<Key, T, Hash, Equal> *me;
+            unsigned int index;
+            using difference_type = std::ptrdiff_t;
+            using value_type = typename robin_hood_hashmap::value_type;
+            using pointer = value_type *;
+            using reference = value_type &;
+            using iterator_category = std::output_iterator_tag;
+
+            iterator(unsigned int i = npos, robin_hood_hashmap<Key, T, Hash, Equal> *m = nullptr) {
+                index = i;
+                me = m;
+            }
+
+            iterator(const iterator &other) = default;
+
+            iterator &operator=(const iterator &other) = default;
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            iterator &operator++() {
+                if (index == npos) {
+                    runtime_error e;
+                    throw e;
+                }
+                index = me->links[index].after;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            iterator &operator--() {
+                if (index == me->head) {
+                    runtime_error e;
+                    throw e;
+                }
+                if (index == npos)index = me->rear;
+                else index = me->links[index].before;
+                return *this;
+            }
+
+            value_type &operator*() const {
+                if (index == npos) {
+                    runtime_error e;
+                    throw e;
+                }
+                return me->value(index);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return me == rhs.me && index == rhs.index;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return me == rhs.me && index == rhs.index;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            value_type *operator->() const {
+                return &(operator*());
+            }
+        };
+
+        class const_iterator {
+        public:
+            const robin_hood_hashmap<Key, T, Hash, Equal> *me;
+            unsigned int index;
+            using difference_type = std::ptrdiff_t;
+            using value_type = typename robin_hood_hashmap::value_type;
+            using pointer = value_type *;
+            using reference = value_type &;
+            using iterator_category = std::output_iterator_tag;
+
+            const_iterator(unsigned int i = npos, const robin_hood_hashmap<Key, T, Hash, Equal> *m = nullptr) {
+                index = i;
+                me = m;
+            }
+
+            const_iterator(const const_iterator &other) = default;
+
+            const_iterator(const iterator &other) {
+                index = other.index;
+                me = other.me;
+            }
+
+            const_iterator &operator=(const const_iterator &other) = default;
+
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            const_iterator &operator++() {
+                if (index == npos) {
+                    runtime_error e;
+                    throw e;
+                }
+                index = me->links[index].after;
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            const_iterator &operator--() {
+                if (index == me->head) {
+                    runtime_error e;
+                    throw e;
+                }
+                if (index == npos)index = me->rear;
+                else index = me->links[index].before;
+                return *this;
+            }
+
+            const value_type &operator*() const {
+                if (index == npos) {
+                    runtime_error e;
+                    throw e;
+                }
+                return me->value(index);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return me == rhs.me && index == rhs.index;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return me == rhs.me && index == rhs.index;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            const value_type *operator->() const {
+                return &(operator*());
+            }
+        };
+
+    private:
+        Hash hash;
+        Equal equal;
+        size_t scale = 0;
+
+        //第k块有8<<k个entry，按下标顺序排下去；块分配了就不再动，元素的地址一直不变
+        //entry里用placement new构造，空闲的位置没有对象
+        static const int chunk_limit = 30;
+        value_type *chunks[chunk_limit] = {};
+        int chunk_count = 0;
+        link *links = nullptr;
+        unsigned int capacity = 0;
+        unsigned int used = 0;//[0, used)是用过的entry
+        unsigned int free_head = npos;
+        unsigned int head = npos;
+        unsigned int rear = npos;
+
+        slot *table = nullptr;
+        unsigned int mask = 0;//桶数减一，桶数是2的幂
+
+        //std::hash对整数是恒等映射，乘一个黄金分割数把高位打散下来
+        unsigned int hash_of(const Key &key) const {
+            unsigned long long h = (unsigned long long) hash.operator()(key);
+            return (unsigned int) ((h * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        value_type &value(unsigned int e) const {
+            unsigned long long x = (unsigned long long) e + 8;
+            int k = 60 - __builtin_clzll(x);
+            return chunks[k][x - (8ull << k)];
+        }
+
+        unsigned int distance(unsigned int pos) const {
+            return (pos - table[pos].hash) & mask;
+        }
+
+        //返回key所在的槽，没有返回npos
+        unsigned int find_slot(const Key &key, unsigned int h) const {
+            unsigned int pos = h & mask, dist = 0;
+            while (true) {
+                if (table[pos].entry == npos)return npos;
+                if (distance(pos) < dist)return npos;//robin hood：后面不可能再有了
+                if (table[pos].hash == h && equal.operator()(value(table[pos].entry).first, key))return pos;
+                pos = (pos + 1) & mask;
+                ++dist;
+            }
+        }
+
+        //劫富济贫：探测距离短的让位给探测距离长的
+        void insert_slot(unsigned int e, unsigned int h) {
+            slot cur = {e, h};
+            unsigned int pos = h & mask, dist = 0;
+            while (true) {
+                if (table[pos].entry == npos) {
+                    table[pos] = cur;
+                    return;
+                }
+                unsigned int d = distance(pos);
+                if (d < dist) {
+                    slot tmp = table[pos];
+                    table[pos] = cur;
+                    cur = tmp;
+                    dist = d;
+                }
+                pos = (pos + 1) & mask;
+                ++dist;
+            }
+        }
+
+        //删除后把后面的元素往前挪，不用墓碑
+        void erase_slot(unsigned int pos) {
+            unsigned int next = (pos + 1) & mask;
+            while (table[next].entry != npos && distance(next) != 0) {
+                table[pos] = table[next];
+                pos = next;
+                next = (next + 1) & mask;
+            }
+            table[pos].entry = npos;
+        }
+
+        void rehash(unsigned int buckets) {
+            free((void *) table);
+            table = (slot *) malloc(sizeof(slot) * buckets);
+            mask = buckets - 1;
+            for (unsigned int i = 0; i < buckets; ++i)table[i].entry = npos;
+            for (unsigned int i = head; i != npos; i = links[i].after)insert_slot(i, links[i].hash);
+        }
+
+        //装载因子不超过0.8
+        static unsigned int buckets_for(size_t n) {
+            unsigned int buckets = 8;
+            while ((size_t) buckets * 4 < n * 5)buckets *= 2;
+            return buckets;
+        }
+
+        //只有links要搬，元素所在的块是新加的
+        void reserve_entries(unsigned int n) {
+            if (n <= capacity)return;
+            unsigned int old_capacity = capacity;
+            while (capacity < n) {
+                chunks[chunk_count] = (value_type *) malloc(sizeof(value_type) * (8u << chunk_count));
+                capacity += 8u << chunk_count;
+                ++chunk_count;
+            }
+            link *new_links = (link *) malloc(sizeof(link) * capacity);
+            for (unsigned int i = 0; i < used && i < old_capacity; ++i)new_links[i] = links[i];
+            free((void *) links);
+            links = new_links;
+        }
+
+        unsigned int allocate_entry() {
+            if (free_head != npos) {
+                unsigned int e = free_head;
+                free_head = links[e].after;
+                return e;
+            }
+            if (used == capacity)reserve_entries(capacity + 1);
+            return used++;
+        }
+
+        //v的key不在表里
+        unsigned int append(const value_type &v, unsigned int h) {
+            if ((size_t) (mask + 1) * 4 < (scale + 1) * 5)rehash((mask + 1) * 2);
+            unsigned int e = allocate_entry();
+            new(&value(e))value_type(v);
+            links[e].before = rear;
+            links[e].after = npos;
+            links[e].hash = h;
+            if (rear == npos)head = e;
+            else links[rear].after = e;
+            rear = e;
+            insert_slot(e, h);
+            ++scale;
+            return e;
+        }
+
+        void remove_(unsigned int e) {
+            //hash存在link里，找槽不用再算hash，也不用比较key
+            unsigned int pos = links[e].hash & mask;
+            while (table[pos].entry != e)pos = (pos + 1) & mask;
+            erase_slot(pos);
+            if (links[e].before == npos)head = links[e].after;
+            else links[links[e].before].after = links[e].after;
+            if (links[e].after == npos)rear = links[e].before;
+            else links[links[e].after].before = links[e].before;
+            value(e).~value_type();
+            links[e].before = free_mark;
+            links[e].after = free_head;
+            free_head = e;
+            --scale;
+        }
+
+        unsigned int find_(const Key &key) const {
+            unsigned int pos = find_slot(key, hash_of(key));
+            return pos == npos ? npos : table[pos].entry;
+        }
+
+        void copy_from(const robin_hood_hashmap &other) {
+            reserve_entries(other.scale < 8 ? 8 : (unsigned int) other.scale);
+            if (mask + 1 < buckets_for(other.scale))rehash(buckets_for(other.scale));
+            for (unsigned int i = other.head; i != npos; i = other.links[i].after)
+                append(other.value(i), other.links[i].hash);
+        }
+
+    public:
+
+        robin_hood_hashmap() {
+            rehash(8);
+        }
+
+        robin_hood_hashmap(const robin_hood_hashmap &other) {
+            rehash(8);
+            copy_from(other);
+        }
+
+        robin_hood_hashmap &operator=(const robin_hood_hashmap &other) {
+            if (&other == this)return *this;
+            clear();
+            copy_from(other);
+            return *this;
+        }
+
+        ~robin_hood_hashmap() {
+            clear();
+            for (int i = 0; i < chunk_count; ++i)free((void *) chunks[i]);
+            free((void *) links);
+            free((void *) table);
+        }
+
+        T &at(const Key &key) {
+            unsigned int e = find_(key);
+            if (e == npos) {
+                index_out_of_bound err;
+                throw err;
+            }
+            return value(e).second;
+        }
+
+        const T &at(const Key &key) const {
+            unsigned int e = find_(key);
+            if (e == npos) {
+                index_out_of_bound err;
+                throw err;
+            }
+            return value(e).second;
+        }
+
+        T &operator[](const Key &key) {
+            unsigned int h = hash_of(key);
+            unsigned int pos = find_slot(key, h);
+            if (pos != npos)return value(table[pos].entry).second;
+            return value(append(value_type(key, T()), h)).second;
+        }
+
+        /**
+         * behave like at() throw index_out_of_bound if such key does not exist.
+         */
+        const T &operator[](const Key &key) const {
+            return at(key);
+        }
+
+        iterator begin() {
+            return iterator(head, this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(head, this);
+        }
+
+        iterator end() {
+            return iterator(npos, this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(npos, this);
+        }
+
+        bool empty() const {
+            return scale == 0;
+        }
+
+        size_t size() const {
+            return scale;
+        }
+
+        /**
+         * clears the contents, the memory of the entries and the table is kept for reuse.
+         */
+        void clear() {
+            for (unsigned int i = head; i != npos; i = links[i].after)value(i).~value_type();
+            for (unsigned int i = 0; i <= mask; ++i)table[i].entry = npos;
+            scale = 0;
+            used = 0;
+            free_head = npos;
+            head = rear = npos;
+        }
+
+        /**
+         * insert an element.
+         * return a pair, the first of the pair is
+         *   the iterator to the new element (or the element that prevented the insertion),
+         *   the second one is true if insert successfully, or false.
+         */
+        pair<iterator, bool> insert(const value_type &v) {
+            unsigned int h = hash_of(v.first);
+            unsigned int pos = find_slot(v.first, h);
+            if (pos != npos)return {iterator(table[pos].entry, this), false};
+            return {iterator(append(v, h), this), true};
+        }
+
+        /**
+         * erase the element at pos.
+         *
+         * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
+         */
+        void erase(iterator pos) {
+            if (this != pos.me || pos.index >= used || links[pos.index].before == free_mark) {
+                runtime_error e;
+                throw e;
+            }
+            remove_(pos.index);
+        }
+
+        size_t count(const Key &key) const {
+            return find_(key) == npos ? 0 : 1;
+        }
+
+        iterator find(const Key &key) {
+            return iterator(find_(key), this);
+        }
+
+        const_iterator find(const Key &key) const {
+            return const_iterator(find_(key), this);
+        }
+    };
+
+}
+
+#endif
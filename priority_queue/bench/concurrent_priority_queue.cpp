@@ -0,0 +1,63 @@
+//多线程下push/pop的吞吐量：全局锁+priority_queue 对比 concurrent_priority_queue
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include "concurrent_priority_queue.hpp"
+
+const int ops_per_thread = 400000;
+
+struct locked_queue {
+    std::mutex lock;
+    sjtu::priority_queue<int> heap;
+
+    void push(int x) {
+        std::lock_guard<std::mutex> guard(lock);
+        heap.push(x);
+    }
+
+    bool try_pop(int &out) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (heap.empty())return false;
+        out = heap.top();
+        heap.pop();
+        return true;
+    }
+};
+
+template<class Queue>
+double run(Queue &q, int threads) {
+    for (int i = 0; i < 1000; ++i)q.push(rand());
+    auto start = std::chrono::steady_clock::now();
+    std::thread *workers = new std::thread[threads];
+    for (int t = 0; t < threads; ++t) {
+        workers[t] = std::thread([&q, t]() {
+            unsigned int seed = t * 7919 + 1;
+            int x;
+            for (int i = 0; i < ops_per_thread; ++i) {
+                seed = seed * 1103515245 + 12345;
+                if (i & 1)q.try_pop(x);
+                else q.push((int) (seed >> 8));
+            }
+        });
+    }
+    for (int t = 0; t < threads; ++t)workers[t].join();
+    delete[]workers;
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    return ops_per_thread * (double) threads / cost.count() / 1e6;
+}
+
+int main() {
+    std::cout << "threads\tglobal_lock\trelaxed\tstrict\t(Mops/s)" << std::endl;
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        locked_queue global;
+        sjtu::concurrent_priority_queue<int> relaxed(2 * threads, sjtu::relaxed_order);
+        sjtu::concurrent_priority_queue<int> strict(2 * threads, sjtu::strict_order);
+        double a = run(global, threads);
+        double b = run(relaxed, threads);
+        double c = run(strict, threads);
+        std::cout << threads << "\t" << a << "\t" << b << "\t" << c << std::endl;
+    }
+    return 0;
+}
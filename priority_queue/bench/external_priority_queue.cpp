@@ -0,0 +1,42 @@
+//内存上限下的外存优先队列：./bench_external_priority_queue [内存上限MB] [元素个数]
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "external_priority_queue.hpp"
+
+int main(int argc, char *argv[]) {
+    size_t cap_mb = argc > 1 ? atoi(argv[1]) : 8;
+    size_t n = argc > 2 ? atoll(argv[2]) : 20000000;
+    //3/4的内存给插入堆（二叉堆扩容后最多是run_size的两倍，写段的时候还要一份run_size的），剩下的给各段的读缓冲
+    size_t buffer_size = 1 << 12;
+    size_t run_size = cap_mb * (1 << 20) / 8 / sizeof(long long);
+    int max_open = 0;
+    std::cout << "elements " << n << ", data " << n * sizeof(long long) / (1 << 20) << "MB, cap " << cap_mb
+              << "MB, run_size " << run_size << std::endl;
+
+    sjtu::external_priority_queue<long long> q(run_size, buffer_size);
+    auto start = std::chrono::steady_clock::now();
+    unsigned long long seed = 1;
+    for (size_t i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        q.push((long long) (seed >> 20));
+        if (q.runs_open() > max_open)max_open = q.runs_open();
+    }
+    auto middle = std::chrono::steady_clock::now();
+    long long last = q.top();
+    bool ordered = true;
+    while (!q.empty()) {
+        if (q.top() > last)ordered = false;
+        last = q.top();
+        q.pop();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> push_cost = middle - start, pop_cost = end - middle;
+    size_t memory = (3 * run_size + max_open * buffer_size) * sizeof(long long);
+    std::cout << "runs " << q.runs_spilled() << ", at most " << max_open << " open, memory bound "
+              << memory / (1 << 20) << "MB" << std::endl;
+    std::cout << "push " << n / push_cost.count() / 1e6 << " Mops/s, pop " << n / pop_cost.count() / 1e6
+              << " Mops/s" << (ordered ? "" : ", ORDER BROKEN") << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+//合并k个有序段：pop+push 对比 kway_merge 的堆模式和败者树模式，统计比较次数和时间
+#include <iostream>
+#include <chrono>
+#include "kway_merge.hpp"
+
+long long comparisons = 0;
+
+struct counting_less {
+    bool operator()(int a, int b) const {
+        ++comparisons;
+        return a < b;
+    }
+};
+
+struct run_head {
+    int value;
+    int run;
+};
+
+struct run_head_compare {
+    bool operator()(const run_head &a, const run_head &b) const {
+        ++comparisons;
+        return a.value > b.value;
+    }
+};
+
+template<class Merge>
+void report(const char *name, Merge merge) {
+    comparisons = 0;
+    auto start = std::chrono::steady_clock::now();
+    long long check = merge();
+    std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+    std::cout << name << "\t" << cost.count() << "ms\t" << comparisons << " comparisons\t(check " << check << ")"
+              << std::endl;
+}
+
+int main() {
+    const int k = 256, length = 20000;
+    int **runs = new int *[k];
+    const int **firsts = new const int *[k], **lasts = new const int *[k];
+    for (int i = 0; i < k; ++i) {
+        runs[i] = new int[length];
+        int x = i;
+        for (int j = 0; j < length; ++j) {
+            x += (j * 7 + i) % 13;
+            runs[i][j] = x;
+        }
+        firsts[i] = runs[i];
+        lasts[i] = runs[i] + length;
+    }
+    std::cout << k << " runs of " << length << std::endl;
+    report("pop+push", [&]() {
+        sjtu::priority_queue<run_head, run_head_compare> heap;
+        int *pos = new int[k]();
+        for (int i = 0; i < k; ++i)heap.push({runs[i][0], i});
+        long long check = 0;
+        while (!heap.empty()) {
+            run_head h = heap.top();
+            heap.pop();
+            check = check * 31 + h.value;
+            if (++pos[h.run] < length)heap.push({runs[h.run][pos[h.run]], h.run});
+        }
+        delete[]pos;
+        return check;
+    });
+    report("heap", [&]() {
+        sjtu::kway_merge<const int *, counting_less> merge(firsts, lasts, k, sjtu::heap_merge);
+        long long check = 0;
+        for (; !merge.empty(); merge.next())check = check * 31 + merge.front();
+        return check;
+    });
+    report("loser tree", [&]() {
+        sjtu::kway_merge<const int *, counting_less> merge(firsts, lasts, k, sjtu::loser_tree_merge);
+        long long check = 0;
+        for (; !merge.empty(); merge.next())check = check * 31 + merge.front();
+        return check;
+    });
+    for (int i = 0; i < k; ++i)delete[]runs[i];
+    delete[]runs;
+    delete[]firsts;
+    delete[]lasts;
+    return 0;
+}
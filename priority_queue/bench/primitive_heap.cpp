@@ -0,0 +1,41 @@
+//int/double 的堆：std::less/std::greater 走快速路径，自定义比较器走通用路径
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "binary_heap.hpp"
+
+//和std::less一样的比较，但不是std::less，所以不会走快速路径
+template<typename T>
+struct plain_less {
+    bool operator()(const T &a, const T &b) const {
+        return a < b;
+    }
+};
+
+template<typename T, class Compare>
+double run(int n) {
+    sjtu::priority_queue<T, Compare> q;
+    unsigned long long seed = 42;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        q.push((T) (seed >> 33));
+    }
+    T sum = 0;
+    while (!q.empty()) {
+        sum += q.top();
+        q.pop();
+    }
+    std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+    if (sum == (T) -1)std::cout << "";
+    return cost.count();
+}
+
+int main(int argc, char *argv[]) {
+    const int n = argc > 1 ? atoi(argv[1]) : 4000000;
+    std::cout << "type\tgeneric(ms)\tfast path(ms)" << std::endl;
+    std::cout << "int\t" << run<int, plain_less<int>>(n) << "\t" << run<int, std::less<int>>(n) << std::endl;
+    std::cout << "double\t" << run<double, plain_less<double>>(n) << "\t" << run<double, std::less<double>>(n)
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,75 @@
+//同一串单调的操作序列分别交给基数堆和二叉堆
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "radix_heap.hpp"
+#include "binary_heap.hpp"
+
+struct operation {
+    bool is_push;
+    unsigned int key;
+};
+
+//模拟dijkstra/定时器：每次push的键都是 当前最小键 + [0, range) 的随机数
+operation *make_trace(int n, unsigned int range, int &length) {
+    operation *trace = new operation[2 * n];
+    sjtu::priority_queue<unsigned int, std::greater<unsigned int>> model;
+    unsigned int now = 0;
+    length = 0;
+    for (int i = 0; i < n; ++i) {
+        int pushes = 1 + rand() % 3;
+        for (int j = 0; j < pushes && length < 2 * n; ++j) {
+            unsigned int key = now + (unsigned int) rand() % range;
+            trace[length++] = {true, key};
+            model.push(key);
+        }
+        if (length < 2 * n && !model.empty()) {
+            now = model.top();
+            model.pop();
+            trace[length++] = {false, 0};
+        }
+    }
+    return trace;
+}
+
+template<class Run>
+double measure(Run run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+    return cost.count();
+}
+
+int main() {
+    const int n = 2000000;
+    unsigned int ranges[] = {64, 4096, 1u << 16, 1u << 24};
+    std::cout << "key range\tbinary_heap(ms)\tradix_heap(ms)" << std::endl;
+    for (unsigned int range : ranges) {
+        int length;
+        operation *trace = make_trace(n, range, length);
+        unsigned long long check_a = 0, check_b = 0;
+        double a = measure([&]() {
+            sjtu::priority_queue<unsigned int, std::greater<unsigned int>> heap;
+            for (int i = 0; i < length; ++i) {
+                if (trace[i].is_push)heap.push(trace[i].key);
+                else {
+                    check_a += heap.top();
+                    heap.pop();
+                }
+            }
+        });
+        double b = measure([&]() {
+            sjtu::radix_heap<unsigned int, int> heap;
+            for (int i = 0; i < length; ++i) {
+                if (trace[i].is_push)heap.push(trace[i].key, i);
+                else {
+                    check_b += heap.top().first;
+                    heap.pop();
+                }
+            }
+        });
+        std::cout << range << "\t" << a << "\t" << b << (check_a == check_b ? "" : "\tMISMATCH") << std::endl;
+        delete[]trace;
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+//稳定模式相对于普通模式的开销，优先级只有16种，大量相等的元素
+#include <iostream>
+#include <chrono>
+#include "stable_priority_queue.hpp"
+
+struct job {
+    int priority;
+    int id;
+};
+
+struct job_compare {
+    bool operator()(const job &a, const job &b) const {
+        return a.priority < b.priority;
+    }
+};
+
+template<class Queue>
+double run(Queue &q, int n, bool &fifo) {
+    auto start = std::chrono::steady_clock::now();
+    unsigned int seed = 1;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        q.push({(int) (seed >> 16) % 16, i});
+    }
+    fifo = true;
+    job last = q.top();
+    q.pop();
+    while (!q.empty()) {
+        if (q.top().priority == last.priority && q.top().id < last.id)fifo = false;
+        last = q.top();
+        q.pop();
+    }
+    std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+    return cost.count();
+}
+
+int main() {
+    std::cout << "elements\tunstable(ms)\tstable(ms)" << std::endl;
+    for (int n = 10000; n <= 10000000; n *= 10) {
+        bool fifo_a, fifo_b;
+        sjtu::priority_queue<job, job_compare> a;
+        sjtu::stable_priority_queue<job, job_compare> b;
+        double cost_a = run(a, n, fifo_a), cost_b = run(b, n, fifo_b);
+        std::cout << n << "\t" << cost_a << (fifo_a ? "" : " (not fifo)") << "\t" << cost_b
+                  << (fifo_b ? "" : " (NOT FIFO)") << std::endl;
+    }
+    return 0;
+}
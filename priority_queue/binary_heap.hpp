@@ -1,13 +1,26 @@
 //二项堆
 #ifndef SJTU_PRIORITY_QUEUE_HPP
 #define SJTU_PRIORITY_QUEUE_HPP
+//left_heap.hpp 用的是同一个guard，依赖二叉堆专有接口的头文件靠这个宏区分
+#define SJTU_BINARY_HEAP_HPP
 
 #include <cstddef>
 #include <functional>
+#include <iostream>
+#include <type_traits>
 #include "exceptions.hpp"
 
 namespace sjtu {
 
+/**
+ * arithmetic T ordered by std::less / std::greater: the sift-down can walk the hole
+ * down to a leaf picking the child without a branch, and then sift the element back up.
+ */
+    template<typename T, class Compare>
+    struct heap_fast_path : std::integral_constant<bool, std::is_arithmetic<T>::value && (
+            std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::greater<T>>::value)> {
+    };
+
 /**
  * a container like std::priority_queue which is a heap internal.
  */
@@ -28,7 +41,34 @@ namespace sjtu {
             free((void *) tmp);
         }
 
-        void percolate(int hole) {//find downwards for a suitable place for the element in the hole
+        void percolate(int hole) {
+            percolate(hole, heap_fast_path<T, Compare>());
+        }
+
+        void percolate(int hole, std::true_type) {
+            T x = data[hole];
+            int start = hole, child = hole * 2;
+            //两个孩子都在的时候，比较的结果直接加到下标上，选孩子不需要分支
+            while (child < current_size) {
+                __builtin_prefetch(data + child * 4);//孙子的孩子们是连续的，提前取进cache
+                child += cmp.operator()(data[child], data[child + 1]);
+                data[hole] = data[child];
+                hole = child;
+                child = hole * 2;
+            }
+            if (child == current_size) {
+                data[hole] = data[child];
+                hole = child;
+            }
+            //洞已经到了叶子，把x从这里往上放回去，最多回到出发的位置
+            while (hole > start && cmp.operator()(data[hole / 2], x)) {
+                data[hole] = data[hole / 2];
+                hole /= 2;
+            }
+            data[hole] = x;
+        }
+
+        void percolate(int hole, std::false_type) {//find downwards for a suitable place for the element in the hole
             while (hole <= current_size) {
                 int child = hole * 2;//the hole's left child,
                 // then we need to check if its the right child exists and find the smaller one to exchange
@@ -45,6 +85,36 @@ namespace sjtu {
             }
         }
 
+        //根上空出了一个洞（Floyd）：洞沿着更优的孩子沉到叶子，每层只比较两个孩子，
+        //再把x从叶子往上浮；堆尾的元素通常本来就该在底层，往上浮不了几步
+        void refill_root(T x) {
+            int hole = 1, child = 2;
+            while (child < current_size) {
+                if (cmp.operator()(data[child], data[child + 1]))++child;
+                data[hole] = data[child];
+                hole = child;
+                child = hole * 2;
+            }
+            if (child == current_size) {
+                data[hole] = data[child];
+                hole = child;
+            }
+            while (hole > 1 && cmp.operator()(data[hole / 2], x)) {
+                data[hole] = data[hole / 2];
+                hole /= 2;
+            }
+            data[hole] = x;
+        }
+
+        void percolate_up(int hole) {//find upwards for a suitable place for the element in the hole
+            T tmp = data[hole];
+            while (hole > 1 && cmp.operator()(data[hole / 2], tmp)) {
+                data[hole] = data[hole / 2];
+                hole /= 2;
+            }
+            data[hole] = tmp;
+        }
+
     public:
         void traverse() {
             std::cout << "Traverse: " << std::endl;
@@ -74,7 +144,7 @@ namespace sjtu {
 
         priority_queue &operator=(const priority_queue &other) {
             if (this == &other)return *this;
-            for (int i = 0; i < current_size; ++i)data[i].~T();
+            for (int i = 1; i <= current_size; ++i)data[i].~T();
             free((void *) data);
             max_size = other.max_size;
             current_size = other.current_size;
@@ -109,16 +179,36 @@ namespace sjtu {
             ++current_size;
             new(data + current_size)T(e);//add a node for the pushing,
             // the new element will be put into this one, now up and find the correct place
-            for (int i = current_size; i > 0;)//find its parent and judge if the place is correct
-            {
-                int parent = i / 2;
-                if (parent > 0 && cmp.operator()(data[parent], e)) {
-                    data[i] = data[parent];
-                    i = parent;
-                } else {
-                    data[i] = e;
-                    break;
-                }
+            percolate_up(current_size);
+        }
+
+        /**
+         * push all the elements in [first, last).
+         * a small batch is sifted up one by one; a large batch is appended first,
+         * then the ancestors of the new slots are fixed bottom-up level by level,
+         * so every ancestor is sifted down only once for the whole batch.
+         */
+        template<class InputIt>
+        void push_bulk(InputIt first, InputIt last) {
+            int old_size = current_size;
+            for (; first != last; ++first) {
+                if (current_size + 1 >= max_size)DoubleSpace();
+                ++current_size;
+                new(data + current_size)T(*first);
+            }
+            int batch = current_size - old_size, depth = 0;
+            for (int i = current_size; i > 1; i /= 2)++depth;
+            if (batch <= depth) {
+                for (int i = old_size + 1; i <= current_size; ++i)percolate_up(i);
+                return;
+            }
+            //新元素在[left, right]，每次往上取它们父亲的区间，从右往左percolate，保证孩子先于父亲处理
+            int left = old_size + 1, right = current_size;
+            while (right > 1) {
+                left /= 2;
+                right /= 2;
+                if (left < 1)left = 1;
+                for (int i = right; i >= left; --i)percolate(i);
             }
         }
 
@@ -138,6 +228,54 @@ namespace sjtu {
             percolate(1);
         }
 
+        /**
+         * delete the top k elements and write them to out, the top one first.
+         * if k is more than size(), all the elements are taken.
+         * a large k is an in-place partial heapsort with a bottom-up sift: the root hole sinks
+         *   to a leaf first and the tail element is placed there and sifted up.
+         * @return the output iterator past the last written element.
+         */
+        template<class OutputIt>
+        OutputIt pop_bulk(size_t k, OutputIt out) {
+            if (k > (size_t) current_size)k = current_size;
+            if (k < 32) {
+                for (size_t i = 0; i < k; ++i) {
+                    *out = data[1];
+                    ++out;
+                    pop();
+                }
+                return out;
+            }
+            //部分堆排序：堆顶放到堆尾的格子里，堆缩小一格，出堆的元素从数组末尾往前排好，最后一次性写出
+            int n = current_size;
+            for (size_t i = 0; i < k; ++i) {
+                T top = data[1], tail = data[current_size];
+                data[current_size] = top;
+                --current_size;
+                if (current_size > 0)refill_root(tail);
+            }
+            for (int i = n; i > current_size; --i) {
+                *out = data[i];
+                ++out;
+                data[i].~T();
+            }
+            return out;
+        }
+
+        /**
+         * replace the top element with e and sift it down once,
+         * cheaper than a pop() followed by a push().
+         * throw container_is_empty if empty() returns true;
+         */
+        void replace_top(const T &e) {
+            if (current_size == 0) {
+                container_is_empty err;
+                throw err;
+            }
+            data[1] = e;
+            percolate(1);
+        }
+
         /**
          * return the number of the elements.
          */
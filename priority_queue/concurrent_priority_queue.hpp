@@ -0,0 +1,163 @@
+//多线程共享的优先队列（MultiQueue）
+#ifndef SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+#define SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+//只用到 push/pop/top/empty，binary_heap.hpp 和 left_heap.hpp 都可以用，先include了哪一个就用哪一个
+#ifndef SJTU_PRIORITY_QUEUE_HPP
+#include "binary_heap.hpp"
+#endif
+
+namespace sjtu {
+
+    enum ordering_mode {
+        relaxed_order, strict_order
+    };
+
+/**
+ * a priority queue shared by several threads.
+ * the elements are spread over a number of heaps (shards), each guarded by its own lock.
+ *
+ * relaxed_order: pop() looks at two random shards and takes the better top of them,
+ *   so the popped element is close to, but not always, the best one.
+ * strict_order: pop() locks every shard and always takes the best element.
+ */
+    template<typename T, class Compare = std::less<T>>
+    class concurrent_priority_queue {
+    private:
+        struct shard {
+            std::mutex lock;
+            priority_queue<T, Compare> heap;
+            char padding[64];//不同的shard不要落在同一条cache line上
+        };
+
+        shard *shards;
+        int shard_count;
+        ordering_mode mode;
+        std::atomic<size_t> current_size;
+        Compare cmp;
+
+        //每个线程自己的随机数，避免共享一个随机数发生器
+        static unsigned int next_random() {
+            static thread_local unsigned int state =
+                    (unsigned int) std::hash<std::thread::id>()(std::this_thread::get_id()) | 1u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        //两个shard都已经上锁，返回堆顶更优的那个，都为空返回nullptr
+        shard *better(shard *a, shard *b) {
+            if (a->heap.empty())return b->heap.empty() ? nullptr : b;
+            if (b->heap.empty())return a;
+            return cmp.operator()(a->heap.top(), b->heap.top()) ? b : a;
+        }
+
+        bool pop_relaxed(T &out) {
+            //随机挑两个shard，拿不到锁就换一对重新挑
+            for (int tries = 0; tries < 2 * shard_count; ++tries) {
+                int i = next_random() % shard_count, j = next_random() % shard_count;
+                if (i == j)j = (j + 1) % shard_count;
+                if (!shards[i].lock.try_lock())continue;
+                if (!shards[j].lock.try_lock()) {
+                    shards[i].lock.unlock();
+                    continue;
+                }
+                shard *s = better(shards + i, shards + j);
+                if (s != nullptr) {
+                    out = s->heap.top();
+                    s->heap.pop();
+                    --current_size;
+                }
+                shards[j].lock.unlock();
+                shards[i].lock.unlock();
+                if (s != nullptr)return true;
+                if (current_size.load() == 0)return false;
+            }
+            //一直挑不中非空的shard，就退化成扫描所有的shard
+            return pop_strict(out);
+        }
+
+        bool pop_strict(T &out) {
+            //按下标顺序上锁，不会死锁
+            for (int i = 0; i < shard_count; ++i)shards[i].lock.lock();
+            shard *best = nullptr;
+            for (int i = 0; i < shard_count; ++i) {
+                if (shards[i].heap.empty())continue;
+                if (best == nullptr || cmp.operator()(best->heap.top(), shards[i].heap.top()))best = shards + i;
+            }
+            if (best != nullptr) {
+                out = best->heap.top();
+                best->heap.pop();
+                --current_size;
+            }
+            for (int i = shard_count - 1; i >= 0; --i)shards[i].lock.unlock();
+            return best != nullptr;
+        }
+
+    public:
+        /**
+         * shards = 0 means two shards for every hardware thread.
+         */
+        explicit concurrent_priority_queue(int shards_ = 0, ordering_mode mode_ = relaxed_order) {
+            if (shards_ <= 0)shards_ = 2 * (int) std::thread::hardware_concurrency();
+            if (shards_ < 2)shards_ = 2;
+            shard_count = shards_;
+            mode = mode_;
+            current_size = 0;
+            shards = new shard[shard_count];
+        }
+
+        concurrent_priority_queue(const concurrent_priority_queue &other) = delete;
+
+        concurrent_priority_queue &operator=(const concurrent_priority_queue &other) = delete;
+
+        ~concurrent_priority_queue() {
+            delete[]shards;
+        }
+
+        /**
+         * push new element to a random shard.
+         */
+        void push(const T &e) {
+            while (true) {
+                shard &s = shards[next_random() % shard_count];
+                if (!s.lock.try_lock())continue;
+                s.heap.push(e);
+                ++current_size;
+                s.lock.unlock();
+                return;
+            }
+        }
+
+        /**
+         * take an element out of the queue.
+         * @return false if the queue is empty, otherwise the element is stored in out.
+         */
+        bool try_pop(T &out) {
+            if (current_size.load() == 0)return false;
+            if (mode == strict_order)return pop_strict(out);
+            else return pop_relaxed(out);
+        }
+
+        /**
+         * return the number of the elements.
+         * it may be out of date as soon as it returns if other threads are working.
+         */
+        size_t size() const {
+            return current_size.load();
+        }
+
+        bool empty() const {
+            return current_size.load() == 0;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "binary_heap.hpp"
+
+//push_bulk/pop_bulk 和逐个push/排序的结果对拍：k<32 逐个pop，k>=32 走部分堆排序，k>size()全取
+template<class T, class Compare>
+bool check(std::vector<T> &ref, sjtu::priority_queue<T, Compare> &q, size_t k)
+{
+	std::vector<T> got;
+	q.pop_bulk(k, std::back_inserter(got));
+	Compare cmp;
+	std::sort(ref.begin(), ref.end(), [&](const T &a, const T &b) { return cmp(b, a); });
+	size_t n = std::min(k, ref.size());
+	bool same = got.size() == n && std::equal(got.begin(), got.end(), ref.begin());
+	ref.erase(ref.begin(), ref.begin() + n);
+	return same && q.size() == ref.size() && (q.empty() || !cmp(q.top(), ref.front()) && !cmp(ref.front(), q.top()));
+}
+
+void TestInt()
+{
+	std::cout << "Testing int..." << std::endl;
+	sjtu::priority_queue<int> q;
+	std::vector<int> ref;
+	srand(29);
+	size_t ks[] = {0, 1, 5, 31, 32, 33, 100, 1000, 5000};
+	int rounds = 0, passed = 0;
+	for (size_t k : ks) {
+		for (int batch : {1, 3, 40, 700, 6000}) {
+			std::vector<int> in;
+			for (int i = 0; i < batch; ++i) in.push_back(rand() % 1000);
+			q.push_bulk(in.begin(), in.end());
+			ref.insert(ref.end(), in.begin(), in.end());
+			++rounds;
+			passed += check(ref, q, k);
+		}
+	}
+	std::cout << "rounds " << rounds << " passed " << passed << " left " << q.size() << std::endl;
+	passed = check(ref, q, q.size() + 10);
+	std::cout << "more than size " << passed << " empty " << q.empty() << std::endl;
+	std::vector<int> none;
+	q.pop_bulk(5, std::back_inserter(none));
+	std::cout << "from empty " << none.size() << std::endl;
+}
+
+void TestGreaterString()
+{
+	std::cout << "Testing string with std::greater..." << std::endl;
+	typedef std::greater<std::string> Cmp;
+	sjtu::priority_queue<std::string, Cmp> q;
+	std::vector<std::string> ref;
+	srand(2029);
+	int rounds = 0, passed = 0;
+	for (size_t k : {3, 31, 32, 64, 500}) {
+		std::vector<std::string> in;
+		for (int i = 0; i < 400; ++i) in.push_back(std::to_string(rand() % 100000));
+		q.push_bulk(in.begin(), in.end());
+		for (int i = 0; i < 5; ++i) {
+			q.push(std::to_string(i));
+			ref.push_back(std::to_string(i));
+		}
+		ref.insert(ref.end(), in.begin(), in.end());
+		++rounds;
+		passed += check(ref, q, k);
+	}
+	std::cout << "rounds " << rounds << " passed " << passed << " left " << q.size() << std::endl;
+	std::vector<std::string> out;
+	q.pop_bulk(40, std::back_inserter(out));
+	std::cout << out[0] << " " << out[1] << " " << out[39] << std::endl;
+	q.pop_bulk(1000000, std::back_inserter(out));
+	std::cout << "all " << out.size() << " sorted " << std::is_sorted(out.begin(), out.end()) << " empty " << q.empty()
+	          << std::endl;
+}
+
+int main()
+{
+	TestInt();
+	TestGreaterString();
+	return 0;
+}
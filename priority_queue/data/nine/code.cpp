@@ -0,0 +1,110 @@
+#include <iostream>
+#include <set>
+#include <iterator>
+#include <string>
+#include <cstdlib>
+
+#include "min_max_heap.hpp"
+
+//随机的 push / pop_min / pop_max 和 std::multiset 对拍
+template<class T>
+bool same_ends(const sjtu::min_max_heap<T> &h, const std::multiset<T> &ref)
+{
+	if (h.size() != ref.size()) return false;
+	if (ref.empty()) return h.empty();
+	return h.top_min() == *ref.begin() && h.top_max() == *ref.rbegin();
+}
+
+void TestSmall()
+{
+	std::cout << "Testing sizes 1-3..." << std::endl;
+	sjtu::min_max_heap<int> h;
+	int thrown = 0;
+	try { h.pop_min(); } catch (sjtu::container_is_empty &) { ++thrown; }
+	try { h.pop_max(); } catch (sjtu::container_is_empty &) { ++thrown; }
+	try { h.top_min(); } catch (sjtu::container_is_empty &) { ++thrown; }
+	try { h.top_max(); } catch (sjtu::container_is_empty &) { ++thrown; }
+	std::cout << "empty throws " << thrown << std::endl;
+	h.push(5);
+	std::cout << h.top_min() << " " << h.top_max() << std::endl;
+	h.pop_max();
+	std::cout << "size " << h.size() << std::endl;
+	//三个元素的所有顺序，分别从两头取
+	int orders[6][3] = {{1, 2, 3}, {1, 3, 2}, {2, 1, 3}, {2, 3, 1}, {3, 1, 2}, {3, 2, 1}};
+	for (auto &o : orders) {
+		sjtu::min_max_heap<int> a, b;
+		for (int x : o) a.push(x), b.push(x);
+		std::cout << o[0] << o[1] << o[2] << ": " << a.top_min() << a.top_max() << " min";
+		while (!a.empty()) std::cout << " " << a.top_min(), a.pop_min();
+		std::cout << ", max";
+		while (!b.empty()) std::cout << " " << b.top_max(), b.pop_max();
+		std::cout << std::endl;
+	}
+	sjtu::min_max_heap<int> c;
+	c.push(2), c.push(2), c.push(1);
+	c.pop_max();
+	std::cout << "duplicates " << c.top_min() << c.top_max();
+	c.pop_min();
+	std::cout << " " << c.top_min() << c.top_max() << std::endl;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	srand(30);
+	for (int range : {5, 1000, 1000000}) {
+		sjtu::min_max_heap<int> h;
+		std::multiset<int> ref;
+		bool same = true;
+		for (int i = 0; i < 200000; ++i) {
+			int op = rand() % 10;
+			if (op < 6 || ref.empty()) {
+				int x = rand() % range;
+				h.push(x);
+				ref.insert(x);
+			} else if (op < 8) {
+				h.pop_min();
+				ref.erase(ref.begin());
+			} else {
+				h.pop_max();
+				ref.erase(std::prev(ref.end()));
+			}
+			if (!same_ends(h, ref)) same = false;
+		}
+		size_t left = ref.size();
+		//剩下的两头交替取完
+		for (bool from_min = true; !ref.empty(); from_min = !from_min) {
+			if (from_min) h.pop_min(), ref.erase(ref.begin());
+			else h.pop_max(), ref.erase(std::prev(ref.end()));
+			if (!same_ends(h, ref)) same = false;
+		}
+		std::cout << "range " << range << ": same " << same << " left " << left << " empty " << h.empty() << std::endl;
+	}
+}
+
+void TestCopy()
+{
+	std::cout << "Testing copy with strings..." << std::endl;
+	sjtu::min_max_heap<std::string> h;
+	std::multiset<std::string> ref;
+	for (int i = 0; i < 1000; ++i) {
+		std::string s = std::to_string(i * 7919 % 1000);
+		h.push(s);
+		ref.insert(s);
+	}
+	sjtu::min_max_heap<std::string> copy(h), assigned;
+	assigned = h;
+	assigned = assigned;
+	h.pop_min();
+	h.pop_max();
+	std::cout << h.size() << " " << copy.size() << " " << assigned.size() << " " << same_ends(copy, ref) << " "
+	          << same_ends(assigned, ref) << " " << copy.top_min() << " " << copy.top_max() << std::endl;
+}
+
+int main()
+{
+	TestSmall();
+	TestRandom();
+	TestCopy();
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+
+#include "radix_heap.hpp"
+
+typedef sjtu::radix_heap<unsigned int, int> Heap;
+
+void print_pops(Heap &h)
+{
+	while (!h.empty()) {
+		std::cout << h.top().first << ":" << h.top().second << " ";
+		h.pop();
+	}
+	std::cout << std::endl;
+}
+
+//top()会把桶的基准提到当前最小的键，之后push的键可以比top()小，只要不比上次pop的小
+void TestBelowTop()
+{
+	std::cout << "Testing keys between the last pop and top()..." << std::endl;
+	Heap h;
+	h.push(10, 1);
+	h.push(20, 2);
+	h.push(1000, 3);
+	h.pop();
+	std::cout << "top " << h.top().first << std::endl;
+	h.push(15, 4);
+	h.push(10, 5);
+	h.push(12, 6);
+	std::cout << "top " << h.top().first << std::endl;
+	h.push(11, 7);
+	print_pops(h);
+	try {
+		h.push(999, 8);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "smaller than the last pop: thrown, size " << h.size() << std::endl;
+	}
+	h.clear();
+	h.push(0, 10);
+	h.push(4294967295u, 11);
+	std::cout << "top " << h.top().first << std::endl;
+	h.pop();
+	std::cout << "top " << h.top().first << std::endl;
+	h.push(1, 12);
+	h.push(2147483648u, 13);
+	print_pops(h);
+}
+
+//随机的单调序列：push的键是 上次pop的键 + 随机数，中间穿插top()，和std::priority_queue对拍
+void TestMonotone()
+{
+	std::cout << "Testing random monotone sequences..." << std::endl;
+	unsigned int ranges[] = {4, 300, 70000, 1u << 20};
+	srand(28);
+	for (unsigned int range : ranges) {
+		Heap h;
+		std::priority_queue<unsigned int, std::vector<unsigned int>, std::greater<unsigned int>> ref;
+		unsigned int now = 0;
+		bool same = true;
+		long long pops = 0;
+		for (int i = 0; i < 100000; ++i) {
+			int pushes = rand() % 3;
+			for (int j = 0; j < pushes; ++j) {
+				unsigned int key = now + (unsigned int) rand() % range;
+				h.push(key, i);
+				ref.push(key);
+			}
+			if (rand() % 2 && !ref.empty() && h.top().first != ref.top()) same = false;
+			if (!ref.empty()) {
+				if (h.top().first != ref.top()) same = false;
+				now = ref.top();
+				h.pop();
+				ref.pop();
+				++pops;
+			}
+		}
+		while (!ref.empty()) {
+			if (h.top().first != ref.top()) same = false;
+			h.pop();
+			ref.pop();
+			++pops;
+		}
+		std::cout << "range " << range << ": pops " << pops << " same " << same << " empty " << h.empty() << std::endl;
+	}
+}
+
+//dijkstra：距离用基数堆和std::priority_queue各算一遍
+void TestDijkstra()
+{
+	std::cout << "Testing dijkstra..." << std::endl;
+	const int n = 5000, m = 50000;
+	std::vector<std::vector<std::pair<int, unsigned int>>> edges(n);
+	srand(2028);
+	for (int i = 0; i < m; ++i) edges[rand() % n].push_back({rand() % n, (unsigned int) (rand() % 1000)});
+	for (int i = 0; i + 1 < n; ++i) edges[i].push_back({i + 1, 100000});
+	std::vector<unsigned int> dist(n, 4294967295u), ref(n, 4294967295u);
+	Heap h;
+	dist[0] = 0;
+	h.push(0, 0);
+	while (!h.empty()) {
+		unsigned int d = h.top().first;
+		int u = h.top().second;
+		h.pop();
+		if (d != dist[u]) continue;
+		for (auto &e : edges[u])
+			if (d + e.second < dist[e.first]) {
+				dist[e.first] = d + e.second;
+				h.push(dist[e.first], e.first);
+			}
+	}
+	std::priority_queue<std::pair<unsigned int, int>, std::vector<std::pair<unsigned int, int>>,
+	        std::greater<std::pair<unsigned int, int>>> q;
+	ref[0] = 0;
+	q.push({0, 0});
+	while (!q.empty()) {
+		unsigned int d = q.top().first;
+		int u = q.top().second;
+		q.pop();
+		if (d != ref[u]) continue;
+		for (auto &e : edges[u])
+			if (d + e.second < ref[e.first]) {
+				ref[e.first] = d + e.second;
+				q.push({ref[e.first], e.first});
+			}
+	}
+	long long sum = 0;
+	for (int i = 0; i < n; ++i) sum += dist[i];
+	std::cout << "same " << (dist == ref) << " sum " << sum << " farthest " << dist[n - 1] << std::endl;
+}
+
+int main()
+{
+	TestBelowTop();
+	TestMonotone();
+	TestDijkstra();
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+
+#include "concurrent_priority_queue.hpp"
+
+//单线程检查：strict模式每次都拿到所有shard里最好的元素，relaxed模式每个元素恰好出来一次
+void TestStrict()
+{
+	std::cout << "Testing strict pop..." << std::endl;
+	sjtu::concurrent_priority_queue<int> q(8, sjtu::strict_order);
+	std::priority_queue<int> ref;
+	srand(20);
+	bool same = true;
+	int out;
+	for (int round = 0; round < 200; ++round) {
+		for (int i = 0; i < 50; ++i) {
+			int x = rand() % 10000;
+			q.push(x);
+			ref.push(x);
+		}
+		for (int i = 0; i < 30; ++i) {
+			if (!q.try_pop(out) || out != ref.top()) same = false;
+			ref.pop();
+		}
+	}
+	std::cout << "size " << q.size() << " " << ref.size() << std::endl;
+	while (!ref.empty()) {
+		if (!q.try_pop(out) || out != ref.top()) same = false;
+		ref.pop();
+	}
+	std::cout << "same order " << same << ", empty " << q.empty() << " " << !q.try_pop(out) << std::endl;
+}
+
+void TestRelaxed()
+{
+	std::cout << "Testing relaxed pop..." << std::endl;
+	const int n = 100000;
+	sjtu::concurrent_priority_queue<int, std::greater<int>> q(16);
+	std::vector<int> seen(n, 0);
+	for (int i = 0; i < n; ++i) q.push((int) (i * 7919LL % n));
+	std::cout << "size " << q.size() << std::endl;
+	int out, popped = 0;
+	long long first_half = 0;
+	while (q.try_pop(out)) {
+		++seen[out];
+		if (++popped <= n / 2) first_half += out;
+	}
+	bool once = true;
+	for (int i = 0; i < n; ++i)
+		if (seen[i] != 1) once = false;
+	std::cout << "popped " << popped << ", each once " << once << ", empty " << q.empty() << std::endl;
+	//relaxed只是近似有序：前一半弹出来的元素整体上应该明显偏小
+	std::cout << "roughly ordered " << (first_half < (long long) n * n / 4) << std::endl;
+	for (int i = 0; i < 10; ++i) q.push(i);
+	popped = 0;
+	while (q.try_pop(out)) ++popped;
+	std::cout << "refill " << popped << " " << q.size() << std::endl;
+}
+
+int main()
+{
+	TestStrict();
+	TestRelaxed();
+	return 0;
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <csignal>
+#include <sys/resource.h>
+
+#include "external_priority_queue.hpp"
+
+//内存里只放得下1000个元素，push的量是它的上百倍，段按4个一层合并，至少合出三层
+const size_t run_size = 1000, buffer_size = 64;
+const int fan_in = 4;
+
+void TestTiers()
+{
+	std::cout << "Testing tiered merging..." << std::endl;
+	sjtu::external_priority_queue<long long> q(run_size, buffer_size, fan_in);
+	std::priority_queue<long long> ref;
+	srand(31);
+	bool same = true;
+	int max_open = 0;
+	for (int i = 0; i < 200000; ++i) {
+		long long x = (long long) rand() * rand() % 1000000007;
+		q.push(x);
+		ref.push(x);
+		if (q.runs_open() > max_open) max_open = q.runs_open();
+		//每push三个pop一个，pop的元素可能在插入堆里也可能在任何一个段里
+		if (i % 3 == 2) {
+			if (q.top() != ref.top()) same = false;
+			q.pop();
+			ref.pop();
+		}
+	}
+	std::cout << "size " << q.size() << " " << ref.size() << ", spilled " << q.runs_spilled() << std::endl;
+	//每层最多留fan_in-1个段，这里最多4层
+	std::cout << "at most " << max_open << " open, bounded " << (max_open <= (fan_in - 1) * 4 + 1) << ", merged " << (max_open < q.runs_spilled())
+	          << std::endl;
+	while (!ref.empty()) {
+		if (q.empty() || q.top() != ref.top()) same = false;
+		q.pop();
+		ref.pop();
+	}
+	std::cout << "same " << same << " empty " << q.empty() << " open " << q.runs_open() << std::endl;
+	try {
+		q.pop();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty pop throws" << std::endl;
+	}
+}
+
+//用RLIMIT_FSIZE让临时文件写不进去：写段、合并失败都要抛异常，而且一个元素都不能丢
+size_t push_until_failure(sjtu::external_priority_queue<int, std::greater<int>> &q, std::priority_queue<int,
+        std::vector<int>, std::greater<int>> &ref, int &next)
+{
+	for (int i = 0; i < 100000; ++i) {
+		int x = next;
+		next = next * 7 % 1000003;
+		ref.push(x);
+		try {
+			q.push(x);
+		} catch (sjtu::runtime_error &) {
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+void TestFailures()
+{
+	std::cout << "Testing write failures..." << std::endl;
+	signal(SIGXFSZ, SIG_IGN);
+	rlimit old;
+	getrlimit(RLIMIT_FSIZE, &old);
+	sjtu::external_priority_queue<int, std::greater<int>> q(run_size, buffer_size, fan_in);
+	std::priority_queue<int, std::vector<int>, std::greater<int>> ref;
+	int next = 1;
+	//一个段4000字节，合并出来的段16000字节：限制在10000字节，写段能成功，合并会失败
+	rlimit limit = old;
+	limit.rlim_cur = 10000;
+	setrlimit(RLIMIT_FSIZE, &limit);
+	size_t pushed = push_until_failure(q, ref, next);
+	std::cout << "merge failed after " << pushed << ", size " << q.size() << " " << ref.size() << ", spilled "
+	          << q.runs_spilled() << std::endl;
+	//限制在1000字节，连一个段都写不出去
+	limit.rlim_cur = 1000;
+	setrlimit(RLIMIT_FSIZE, &limit);
+	pushed = push_until_failure(q, ref, next);
+	std::cout << "spill failed after " << pushed << ", size " << q.size() << " " << ref.size() << ", spilled "
+	          << q.runs_spilled() << std::endl;
+	pushed = push_until_failure(q, ref, next);
+	std::cout << "spill failed again after " << pushed << ", size " << q.size() << " " << ref.size() << std::endl;
+	setrlimit(RLIMIT_FSIZE, &old);
+	for (int i = 0; i < 20000; ++i) {
+		ref.push(next);
+		q.push(next);
+		next = next * 7 % 1000003;
+	}
+	bool same = q.size() == ref.size();
+	while (!ref.empty()) {
+		if (q.empty() || q.top() != ref.top()) same = false;
+		q.pop();
+		ref.pop();
+	}
+	std::cout << "recovered, spilled " << q.runs_spilled() << ", same " << same << " empty " << q.empty() << std::endl;
+}
+
+int main()
+{
+	TestTiers();
+	TestFailures();
+	return 0;
+}
@@ -0,0 +1,295 @@
+//外存优先队列：元素太多放不进内存时，把有序的段写到临时文件里
+#ifndef SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+#define SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <type_traits>
+//要用二叉堆的 replace_top 等接口，left_heap.hpp 先被include了的话就没有二叉堆可用
+#if defined(SJTU_PRIORITY_QUEUE_HPP) && !defined(SJTU_BINARY_HEAP_HPP)
+#error "external_priority_queue.hpp needs the priority_queue of binary_heap.hpp, but left_heap.hpp has been included"
+#endif
+#include "binary_heap.hpp"
+
+namespace sjtu {
+
+/**
+ * a priority queue whose elements may not fit in memory.
+ * new elements go into an in-memory insertion heap of at most run_size elements;
+ * when it is full it is popped out as a sorted run into a temporary file.
+ * top() / pop() merge the insertion heap and the heads of all the runs,
+ * every run being read back through a buffer of buffer_size elements.
+ * runs are merged by size tiers: once fan_in runs of the same tier are open they are merged into one run
+ *   of the next tier, so at most about (fan_in - 1) * log_fan_in(size() / run_size) + 1 files are open
+ *   and every element is rewritten only once per tier.
+ * the memory used is about (3 * run_size + open runs * buffer_size) * sizeof(T).
+ * T is written to the files byte by byte, so it has to be trivially copyable.
+ * if push() throws (a temporary file cannot be created or written), no element is lost.
+ */
+    template<typename T, class Compare = std::less<T>>
+    class external_priority_queue {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "external_priority_queue needs a trivially copyable T");
+
+    private:
+        struct run {
+            FILE *file;//读完了就关掉，是nullptr
+            T *buffer;
+            size_t pos;//buffer中下一个要读的位置
+            size_t loaded;//buffer中读进来的元素个数
+            int tier;//直接写出来的段是0，fan_in个第k层的段合成一个第k+1层的段
+        };
+
+        struct head {
+            T value;
+            int run;
+        };
+
+        struct head_compare {
+            Compare cmp;
+
+            bool operator()(const head &a, const head &b) const {
+                return cmp.operator()(a.value, b.value);
+            }
+        };
+
+        priority_queue<T, Compare> insertion;
+        priority_queue<head, head_compare> heads;//每个没读完的段的当前元素
+        run *runs;//按写出来的先后排，层数不增
+        int run_count;
+        int run_capacity;
+        int fan_in;
+        int spilled;
+        size_t run_size;
+        size_t buffer_size;
+        size_t size_;
+        Compare cmp;
+
+        void DoubleSpace() {
+            run_capacity = (run_capacity == 0 ? 4 : run_capacity * 2);
+            run *tmp = runs;
+            runs = (run *) malloc(sizeof(run) * run_capacity);
+            for (int i = 0; i < run_count; ++i)runs[i] = tmp[i];
+            free((void *) tmp);
+        }
+
+        //从文件里读下一块，读不到说明这个段已经读完了，关掉文件
+        bool load(run &r) {
+            r.pos = 0;
+            r.loaded = fread((void *) r.buffer, sizeof(T), buffer_size, r.file);
+            if (r.loaded > 0)return true;
+            close(r);
+            return false;
+        }
+
+        static void close(run &r) {
+            fclose(r.file);
+            free((void *) r.buffer);
+            r.file = nullptr;
+            r.buffer = nullptr;
+        }
+
+        static void fail(FILE *file) {
+            if (file != nullptr)fclose(file);
+            runtime_error e;
+            throw e;
+        }
+
+        //已经写好、倒回开头的文件作为第tier层的段放到最后
+        bool add_run(FILE *file, int tier) {
+            if (run_count == run_capacity)DoubleSpace();
+            run &r = runs[run_count];
+            r.file = file;
+            r.buffer = (T *) malloc(sizeof(T) * buffer_size);
+            r.tier = tier;
+            if (!load(r))return false;
+            heads.push({r.buffer[0], run_count});
+            ++run_count;
+            return true;
+        }
+
+        //去掉读完的段，heads里的编号跟着变，所以整个重建
+        void compact() {
+            int n = 0;
+            for (int i = 0; i < run_count; ++i)
+                if (runs[i].file != nullptr)runs[n++] = runs[i];
+            run_count = n;
+            heads = priority_queue<head, head_compare>();
+            for (int i = 0; i < run_count; ++i)heads.push({runs[i].buffer[runs[i].pos], i});
+        }
+
+        //插入堆满了：先把元素全部按出堆顺序取出来写成一个有序段，写失败了再放回去
+        void spill() {
+            compact();
+            FILE *file = tmpfile();
+            if (file == nullptr)fail(file);
+            size_t n = insertion.size();
+            T *sorted = (T *) malloc(sizeof(T) * n);
+            insertion.pop_bulk(n, sorted);
+            if (fwrite((const void *) sorted, sizeof(T), n, file) != n || fflush(file) != 0) {
+                insertion.push_bulk(sorted, sorted + n);
+                free((void *) sorted);
+                fail(file);
+            }
+            rewind(file);
+            if (!add_run(file, 0)) {
+                insertion.push_bulk(sorted, sorted + n);
+                free((void *) sorted);
+                fail(nullptr);
+            }
+            free((void *) sorted);
+            ++spilled;
+            //最后fan_in个段在同一层就合成一个，合出来的段可能又凑够上一层的fan_in个
+            while (run_count >= fan_in && runs[run_count - fan_in].tier == runs[run_count - 1].tier)
+                merge_tail(run_count - fan_in);
+        }
+
+        //把runs[first, run_count)剩下的元素合成一个段，放在first的位置上
+        //写失败的时候把这些段退回到合并前读到的位置，一个元素都不丢
+        void merge_tail(int first) {
+            long *offsets = (long *) malloc(sizeof(long) * (run_count - first));
+            for (int i = first; i < run_count; ++i)
+                offsets[i - first] = ftell(runs[i].file) - (long) ((runs[i].loaded - runs[i].pos) * sizeof(T));
+            FILE *file = tmpfile();
+            T *out = (T *) malloc(sizeof(T) * buffer_size);
+            bool ok = file != nullptr;
+            priority_queue<head, head_compare> merging;
+            for (int i = first; i < run_count; ++i)merging.push({runs[i].buffer[runs[i].pos], i});
+            size_t n = 0;
+            while (ok && !merging.empty()) {
+                int i = merging.top().run;
+                out[n++] = merging.top().value;
+                if (n == buffer_size) {
+                    ok = fwrite((const void *) out, sizeof(T), n, file) == n;
+                    n = 0;
+                }
+                //读到段尾先不关文件，失败了还要退回去
+                run &r = runs[i];
+                if (++r.pos == r.loaded) {
+                    r.pos = 0;
+                    r.loaded = fread((void *) r.buffer, sizeof(T), buffer_size, r.file);
+                }
+                if (r.loaded == 0)merging.pop();
+                else merging.replace_top({r.buffer[r.pos], i});
+            }
+            if (ok)ok = fwrite((const void *) out, sizeof(T), n, file) == n && fflush(file) == 0;
+            free((void *) out);
+            if (!ok) {
+                for (int i = first; i < run_count; ++i) {
+                    fseek(runs[i].file, offsets[i - first], SEEK_SET);
+                    load(runs[i]);
+                }
+                free((void *) offsets);
+                fail(file);
+            }
+            free((void *) offsets);
+            int tier = runs[first].tier + 1;
+            for (int i = first; i < run_count; ++i)close(runs[i]);
+            rewind(file);
+            compact();//合并掉的段都关了，剩下的就是first之前的
+            if (!add_run(file, tier))fail(nullptr);
+        }
+
+        //true表示当前最优的元素在插入堆里
+        bool top_in_insertion() const {
+            if (heads.empty())return true;
+            if (insertion.empty())return false;
+            return !cmp.operator()(insertion.top(), heads.top().value);
+        }
+
+    public:
+        explicit external_priority_queue(size_t run_size_ = 1 << 20, size_t buffer_size_ = 1 << 12,
+                                         int fan_in_ = 16) {
+            run_size = run_size_ < 1 ? 1 : run_size_;
+            buffer_size = buffer_size_ < 1 ? 1 : buffer_size_;
+            fan_in = fan_in_ < 2 ? 2 : fan_in_;
+            runs = nullptr;
+            run_count = 0;
+            run_capacity = 0;
+            spilled = 0;
+            size_ = 0;
+        }
+
+        external_priority_queue(const external_priority_queue &other) = delete;
+
+        external_priority_queue &operator=(const external_priority_queue &other) = delete;
+
+        ~external_priority_queue() {
+            for (int i = 0; i < run_count; ++i)
+                if (runs[i].file != nullptr)close(runs[i]);
+            free((void *) runs);
+        }
+
+        /**
+         * get the top of the queue.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            if (size_ == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            return top_in_insertion() ? insertion.top() : heads.top().value;
+        }
+
+        void push(const T &e) {
+            insertion.push(e);
+            ++size_;
+            if (insertion.size() >= run_size)spill();
+        }
+
+        /**
+         * delete the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (size_ == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            --size_;
+            if (top_in_insertion()) {
+                insertion.pop();
+                return;
+            }
+            int i = heads.top().run;
+            run &r = runs[i];
+            ++r.pos;
+            if (r.pos == r.loaded && !load(r)) {
+                heads.pop();
+                return;
+            }
+            heads.replace_top({r.buffer[r.pos], i});
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        /**
+         * the number of the sorted runs that have been written to files from the insertion heap.
+         */
+        int runs_spilled() const {
+            return spilled;
+        }
+
+        /**
+         * the number of runs currently open (written, merged, and not read to the end).
+         */
+        int runs_open() const {
+            int n = 0;
+            for (int i = 0; i < run_count; ++i)
+                if (runs[i].file != nullptr)++n;
+            return n;
+        }
+    };
+
+}
+
+#endif
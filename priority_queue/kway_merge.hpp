@@ -0,0 +1,200 @@
+//多路归并：把k个有序序列合成一个有序序列
+#ifndef SJTU_KWAY_MERGE_HPP
+#define SJTU_KWAY_MERGE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+//要用二叉堆的 replace_top 等接口，left_heap.hpp 先被include了的话就没有二叉堆可用
+#if defined(SJTU_PRIORITY_QUEUE_HPP) && !defined(SJTU_BINARY_HEAP_HPP)
+#error "kway_merge.hpp needs the priority_queue of binary_heap.hpp, but left_heap.hpp has been included"
+#endif
+#include "binary_heap.hpp"
+
+namespace sjtu {
+
+    enum merge_mode {
+        heap_merge, loser_tree_merge
+    };
+
+/**
+ * walks through k sorted sequences [firsts[i], lasts[i]) in merged order, i.e. ascending by Compare:
+ *   front() is the current element, next() moves on, empty() tells when everything has been used up.
+ * it is not an iterator (it cannot be copied or compared), just a cursor owning the merge state.
+ *
+ * heap_merge: a binary heap of the current heads, advancing costs one replace_top (a single sift of the root).
+ * loser_tree_merge: a tournament tree of the losers, advancing costs exactly log(k) comparisons,
+ *   and equal elements come out in the order of their sequences.
+ *
+ * the sequences only need input iterators, every element is read once.
+ */
+    template<class InputIt, class Compare = std::less<typename std::iterator_traits<InputIt>::value_type>>
+    class kway_merge {
+    public:
+        typedef typename std::iterator_traits<InputIt>::value_type value_type;
+
+    private:
+        struct source {
+            InputIt cur;
+            InputIt end;
+        };
+
+        struct entry {
+            value_type value;
+            int source;
+        };
+
+        //priority_queue的堆顶是最大的，这里反过来，让最小的在堆顶
+        struct entry_compare {
+            Compare cmp;
+
+            bool operator()(const entry &a, const entry &b) const {
+                return cmp.operator()(b.value, a.value);
+            }
+        };
+
+        source *sources;
+        int k;
+        merge_mode mode;
+        Compare cmp;
+
+        priority_queue<entry, entry_compare> heap;
+
+        //败者树：tree[0]是冠军，tree[1..k-1]是每场比赛的败者，叶子i的父亲是(i+k)/2
+        int *tree;
+        value_type *heads;
+        bool *alive;
+
+        //i是否赢j，读完了的序列当作无穷大
+        bool beats(int i, int j) const {
+            if (!alive[i])return !alive[j] && i < j;
+            if (!alive[j])return true;
+            //相等时下标小的赢，这样一次比较就够了
+            if (i < j)return !cmp.operator()(heads[j], heads[i]);
+            else return cmp.operator()(heads[i], heads[j]);
+        }
+
+        void adjust(int s) {
+            for (int t = (s + k) / 2; t > 0; t /= 2) {
+                if (tree[t] == -1) {//建树的时候，先到的在这里等另一边
+                    tree[t] = s;
+                    return;
+                }
+                if (beats(tree[t], s)) {
+                    int tmp = tree[t];
+                    tree[t] = s;
+                    s = tmp;
+                }
+            }
+            tree[0] = s;
+        }
+
+        void build_heap() {
+            for (int i = 0; i < k; ++i) {
+                if (sources[i].cur == sources[i].end)continue;
+                heap.push({*sources[i].cur, i});
+                ++sources[i].cur;
+            }
+        }
+
+        void build_loser_tree() {
+            tree = new int[k];
+            alive = new bool[k];
+            heads = (value_type *) malloc(sizeof(value_type) * k);
+            for (int i = 0; i < k; ++i) {
+                tree[i] = -1;
+                alive[i] = (sources[i].cur != sources[i].end);
+                if (alive[i]) {
+                    new(heads + i)value_type(*sources[i].cur);
+                    ++sources[i].cur;
+                }
+            }
+            for (int i = k - 1; i >= 0; --i)adjust(i);
+        }
+
+    public:
+        kway_merge(InputIt *firsts, InputIt *lasts, int k_, merge_mode mode_ = heap_merge) {
+            k = k_ < 0 ? 0 : k_;
+            mode = mode_;
+            tree = nullptr;
+            heads = nullptr;
+            alive = nullptr;
+            sources = (source *) malloc(sizeof(source) * (k + 1));
+            for (int i = 0; i < k; ++i)new(sources + i)source{firsts[i], lasts[i]};
+            if (k == 0)return;
+            if (mode == heap_merge)build_heap();
+            else build_loser_tree();
+        }
+
+        kway_merge(const kway_merge &other) = delete;
+
+        kway_merge &operator=(const kway_merge &other) = delete;
+
+        ~kway_merge() {
+            if (heads != nullptr) {
+                for (int i = 0; i < k; ++i)if (alive[i])heads[i].~value_type();
+                free((void *) heads);
+            }
+            delete[]tree;
+            delete[]alive;
+            for (int i = 0; i < k; ++i)sources[i].~source();
+            free((void *) sources);
+        }
+
+        /**
+         * true when every sequence has been used up.
+         */
+        bool empty() const {
+            if (k == 0)return true;
+            if (mode == heap_merge)return heap.empty();
+            else return !alive[tree[0]];
+        }
+
+        /**
+         * the current (smallest) element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const value_type &front() const {
+            if (empty()) {
+                container_is_empty e;
+                throw e;
+            }
+            if (mode == heap_merge)return heap.top().value;
+            else return heads[tree[0]];
+        }
+
+        /**
+         * move to the next element in merged order.
+         * throw container_is_empty if empty() returns true;
+         */
+        void next() {
+            if (empty()) {
+                container_is_empty e;
+                throw e;
+            }
+            if (mode == heap_merge) {
+                source &s = sources[heap.top().source];
+                if (s.cur == s.end)heap.pop();
+                else {
+                    heap.replace_top({*s.cur, heap.top().source});
+                    ++s.cur;
+                }
+            } else {
+                int i = tree[0];
+                source &s = sources[i];
+                if (s.cur == s.end) {
+                    heads[i].~value_type();
+                    alive[i] = false;
+                } else {
+                    heads[i] = *s.cur;
+                    ++s.cur;
+                }
+                adjust(i);
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,195 @@
+//最小-最大堆：同时取最小和最大
+#ifndef SJTU_MIN_MAX_HEAP_HPP
+#define SJTU_MIN_MAX_HEAP_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a double-ended priority queue with a single copy of every element.
+ * the levels of the tree are alternately min levels (the root's) and max levels:
+ * an element on a min level is no bigger than everything below it, and one on a max level no smaller.
+ * top_min() / top_max() are O(1), push() / pop_min() / pop_max() are O(logn).
+ */
+    template<typename T, class Compare = std::less<T>>
+    class min_max_heap {
+    private:
+        T *data;
+        int current_size;
+        int max_size;
+        Compare cmp;
+
+        void DoubleSpace() {
+            max_size *= 2;
+            T *tmp = data;
+            data = (T *) malloc(sizeof(T) * max_size);
+            for (int i = 1; i <= current_size; ++i)new(data + i)T(tmp[i]);
+            for (int i = 1; i <= current_size; ++i)tmp[i].~T();
+            free((void *) tmp);
+        }
+
+        static bool on_min_level(int i) {
+            return ((31 - __builtin_clz((unsigned int) i)) & 1) == 0;
+        }
+
+        //在最小层上比较是 a<b，在最大层上反过来
+        bool before(const T &a, const T &b, bool min_level) const {
+            return min_level ? cmp.operator()(a, b) : cmp.operator()(b, a);
+        }
+
+        void exchange(int i, int j) {
+            T tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+
+        //只和祖父比较，一次跳两层
+        void bubble_up_grandparent(int i, bool min_level) {
+            while (i / 4 > 0 && before(data[i], data[i / 4], min_level)) {
+                exchange(i, i / 4);
+                i /= 4;
+            }
+        }
+
+        void bubble_up(int i) {
+            if (i == 1)return;
+            int parent = i / 2;
+            bool min_level = on_min_level(i);
+            if (before(data[parent], data[i], min_level)) {
+                //放错了层，先和父亲交换，再在父亲那一类层里往上
+                exchange(i, parent);
+                bubble_up_grandparent(parent, !min_level);
+            } else bubble_up_grandparent(i, min_level);
+        }
+
+        void trickle_down(int i) {
+            bool min_level = on_min_level(i);
+            while (i * 2 <= current_size) {
+                //在孩子和孙子中找最该往上走的那个
+                int m = i * 2;
+                if (m + 1 <= current_size && before(data[m + 1], data[m], min_level))m = m + 1;
+                for (int g = i * 4; g <= i * 4 + 3 && g <= current_size; ++g)
+                    if (before(data[g], data[m], min_level))m = g;
+                if (!before(data[m], data[i], min_level))break;
+                exchange(i, m);
+                if (m < i * 4)break;//是孩子，下面就没有孙子层需要处理了
+                if (before(data[m / 2], data[m], min_level))exchange(m, m / 2);
+                i = m;
+            }
+        }
+
+        //删掉位置i上的元素，用最后一个补上
+        void remove(int i) {
+            if (current_size == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            if (i != current_size)data[i] = data[current_size];
+            data[current_size].~T();
+            --current_size;
+            if (i <= current_size)trickle_down(i);
+        }
+
+        int max_index() const {
+            if (current_size == 1)return 1;
+            if (current_size == 2)return 2;
+            return cmp.operator()(data[2], data[3]) ? 3 : 2;
+        }
+
+    public:
+        min_max_heap(int max = 10) {
+            current_size = 0;
+            max_size = max < 2 ? 2 : max;
+            data = (T *) malloc(sizeof(T) * max_size);
+        }
+
+        min_max_heap(const min_max_heap &other) {
+            current_size = other.current_size;
+            max_size = other.max_size;
+            data = (T *) malloc(sizeof(T) * max_size);
+            for (int i = 1; i <= current_size; ++i)new(data + i)T(other.data[i]);
+        }
+
+        ~min_max_heap() {
+            for (int i = 1; i <= current_size; ++i)data[i].~T();
+            free((void *) data);
+        }
+
+        min_max_heap &operator=(const min_max_heap &other) {
+            if (this == &other)return *this;
+            for (int i = 1; i <= current_size; ++i)data[i].~T();
+            free((void *) data);
+            max_size = other.max_size;
+            current_size = other.current_size;
+            data = (T *) malloc(sizeof(T) * max_size);
+            for (int i = 1; i <= current_size; ++i)new(data + i)T(other.data[i]);
+            return *this;
+        }
+
+        /**
+         * get the smallest element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top_min() const {
+            if (current_size == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            return data[1];
+        }
+
+        /**
+         * get the biggest element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top_max() const {
+            if (current_size == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            return data[max_index()];
+        }
+
+        void push(const T &e) {
+            if (current_size + 1 == max_size)DoubleSpace();
+            ++current_size;
+            new(data + current_size)T(e);
+            bubble_up(current_size);
+        }
+
+        /**
+         * delete the smallest element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop_min() {
+            remove(1);
+        }
+
+        /**
+         * delete the biggest element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop_max() {
+            if (current_size == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            remove(max_index());
+        }
+
+        size_t size() const {
+            return current_size;
+        }
+
+        bool empty() const {
+            return current_size == 0;
+        }
+    };
+
+}
+
+#endif
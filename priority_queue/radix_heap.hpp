@@ -0,0 +1,185 @@
+//基数堆：键是无符号整数，并且出堆的键单调不减
+#ifndef SJTU_RADIX_HEAP_HPP
+#define SJTU_RADIX_HEAP_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include "utility.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a monotone min-priority queue for unsigned integer keys, e.g. timers or dijkstra distances.
+ * a pushed key must not be smaller than the last popped key, otherwise runtime_error is thrown
+ *   (calling top() does not raise that bound).
+ * elements are kept in buckets by the highest bit in which their key differs from the last popped key,
+ * so each element moves down at most once per bucket: amortized O(log C) with no comparison sifts.
+ */
+    template<typename Key, typename T>
+    class radix_heap {
+        static_assert(std::is_unsigned<Key>::value, "radix_heap needs an unsigned integer key");
+
+    public:
+        typedef pair<Key, T> value_type;
+
+    private:
+        static const int bucket_count = sizeof(Key) * 8 + 1;
+
+        struct bucket {
+            value_type *data = nullptr;
+            int current_size = 0;
+            int max_size = 0;
+
+            void DoubleSpace() {
+                max_size = (max_size == 0 ? 4 : max_size * 2);
+                value_type *tmp = data;
+                data = (value_type *) malloc(sizeof(value_type) * max_size);
+                for (int i = 0; i < current_size; ++i)new(data + i)value_type(tmp[i]);
+                for (int i = 0; i < current_size; ++i)tmp[i].~value_type();
+                free((void *) tmp);
+            }
+
+            void push(const value_type &v) {
+                if (current_size == max_size)DoubleSpace();
+                new(data + current_size)value_type(v);
+                ++current_size;
+            }
+
+            void pop() {
+                --current_size;
+                data[current_size].~value_type();
+            }
+
+            void clear() {
+                for (int i = 0; i < current_size; ++i)data[i].~value_type();
+                current_size = 0;
+            }
+
+            ~bucket() {
+                clear();
+                free((void *) data);
+            }
+        };
+
+        //top() 需要的时候才把元素往低的桶里面分，所以这些是mutable的
+        mutable bucket buckets[bucket_count];
+        mutable Key last = 0;//桶按和last的最高不同位来分，top()分桶的时候也会把它提上去
+        Key popped = 0;//最后出堆的键，push的键不能比它小
+        size_t size_ = 0;
+
+        static int bucket_of(Key key, Key last) {
+            if (key == last)return 0;
+            return 64 - __builtin_clzll((unsigned long long) (key ^ last));
+        }
+
+        //保证0号桶不空：找到第一个非空的桶，取其中最小的键作为last，把整个桶重新分到更低的桶里
+        void refill() const {
+            if (buckets[0].current_size > 0)return;
+            int i = 1;
+            while (buckets[i].current_size == 0)++i;
+            bucket &b = buckets[i];
+            Key min_key = b.data[0].first;
+            for (int j = 1; j < b.current_size; ++j)
+                if (b.data[j].first < min_key)min_key = b.data[j].first;
+            last = min_key;
+            for (int j = 0; j < b.current_size; ++j)buckets[bucket_of(b.data[j].first, last)].push(b.data[j]);
+            b.clear();
+        }
+
+        //top()把last提到了当前最小的键，之后又push了一个比last小（但不比popped小）的键：
+        //last和key最高的不同位是d，d位以上相同，所以更高的桶不用动，0..d号桶相对key都落在d+1号桶
+        void lower_base(Key key) {
+            int d = bucket_of(key, last) - 1;
+            for (int i = 0; i <= d; ++i) {
+                for (int j = 0; j < buckets[i].current_size; ++j)buckets[d + 1].push(buckets[i].data[j]);
+                buckets[i].clear();
+            }
+            last = key;
+        }
+
+        void copy(const radix_heap &other) {
+            for (int i = 0; i < bucket_count; ++i)
+                for (int j = 0; j < other.buckets[i].current_size; ++j)buckets[i].push(other.buckets[i].data[j]);
+            last = other.last;
+            popped = other.popped;
+            size_ = other.size_;
+        }
+
+    public:
+        radix_heap() = default;
+
+        radix_heap(const radix_heap &other) {
+            copy(other);
+        }
+
+        radix_heap &operator=(const radix_heap &other) {
+            if (this == &other)return *this;
+            clear();
+            copy(other);
+            return *this;
+        }
+
+        /**
+         * get the element with the smallest key.
+         * throw container_is_empty if empty() returns true;
+         */
+        const value_type &top() const {
+            if (size_ == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            refill();
+            return buckets[0].data[buckets[0].current_size - 1];
+        }
+
+        /**
+         * push new element, key must not be smaller than the last popped key.
+         */
+        void push(const Key &key, const T &v) {
+            if (key < popped) {
+                runtime_error e;
+                throw e;
+            }
+            if (key < last)lower_base(key);
+            buckets[bucket_of(key, last)].push(value_type(key, v));
+            ++size_;
+        }
+
+        /**
+         * delete the element with the smallest key.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (size_ == 0) {
+                container_is_empty e;
+                throw e;
+            }
+            refill();
+            popped = last;
+            buckets[0].pop();
+            --size_;
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        /**
+         * remove all the elements, the monotone bound is reset as well.
+         */
+        void clear() {
+            for (int i = 0; i < bucket_count; ++i)buckets[i].clear();
+            last = popped = 0;
+            size_ = 0;
+        }
+    };
+
+}
+
+#endif
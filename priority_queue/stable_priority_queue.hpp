@@ -0,0 +1,88 @@
+//稳定的优先队列：优先级相同的元素按插入的先后出队
+#ifndef SJTU_STABLE_PRIORITY_QUEUE_HPP
+#define SJTU_STABLE_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <functional>
+//binary_heap.hpp 和 left_heap.hpp 都可以用，先include了哪一个就用哪一个
+#ifndef SJTU_PRIORITY_QUEUE_HPP
+#include "binary_heap.hpp"
+#endif
+
+namespace sjtu {
+
+/**
+ * a priority_queue that keeps the insertion order among equal elements (FIFO among ties).
+ * every slot of the underlying heap packs the element with a 64-bit sequence stamp,
+ * the stamp is only compared when Compare says neither element is before the other.
+ */
+    template<typename T, class Compare = std::less<T>>
+    class stable_priority_queue {
+    private:
+        struct slot {
+            T value;
+            unsigned long long stamp;
+        };
+
+        struct slot_compare {
+            Compare cmp;
+
+            //先比较元素，相等时戳小（插入早）的优先级高
+            bool operator()(const slot &a, const slot &b) const {
+                if (cmp.operator()(a.value, b.value))return true;
+                if (cmp.operator()(b.value, a.value))return false;
+                return a.stamp > b.stamp;
+            }
+        };
+
+        priority_queue<slot, slot_compare> heap;
+        unsigned long long next_stamp = 0;
+
+    public:
+        stable_priority_queue() = default;
+
+        stable_priority_queue(const stable_priority_queue &other) = default;
+
+        stable_priority_queue &operator=(const stable_priority_queue &other) = default;
+
+        /**
+         * get the top of the queue, the earliest pushed one among the equal tops.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            return heap.top().value;
+        }
+
+        void push(const T &e) {
+            heap.push({e, next_stamp++});
+        }
+
+        /**
+         * delete the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            heap.pop();
+        }
+
+        size_t size() const {
+            return heap.size();
+        }
+
+        bool empty() const {
+            return heap.empty();
+        }
+
+        /**
+         * move all the elements of other into this one.
+         * ties between the two queues are broken by their own stamps, so each side stays FIFO.
+         */
+        void merge(stable_priority_queue &other) {
+            heap.merge(other.heap);
+            if (other.next_stamp > next_stamp)next_stamp = other.next_stamp;
+        }
+    };
+
+}
+
+#endif
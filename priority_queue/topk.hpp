@@ -0,0 +1,110 @@
+//只保留最优的K个元素的堆
+#ifndef SJTU_TOPK_HPP
+#define SJTU_TOPK_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+//要用二叉堆的 replace_top 等接口，left_heap.hpp 先被include了的话就没有二叉堆可用
+#if defined(SJTU_PRIORITY_QUEUE_HPP) && !defined(SJTU_BINARY_HEAP_HPP)
+#error "topk.hpp needs the priority_queue of binary_heap.hpp, but left_heap.hpp has been included"
+#endif
+#include "binary_heap.hpp"
+
+namespace sjtu {
+
+/**
+ * keeps the best K elements of a stream, "best" in the sense of priority_queue<T, Compare>,
+ * i.e. the elements that priority_queue::top() would return first.
+ * the memory is O(K) however many elements are pushed.
+ */
+    template<typename T, size_t K, class Compare = std::less<T>>
+    class topk {
+    private:
+        //反过来比较，堆顶就是当前K个赢家里最差的那个
+        struct reverse_compare {
+            Compare cmp;
+
+            bool operator()(const T &a, const T &b) const {
+                return cmp.operator()(b, a);
+            }
+        };
+
+        priority_queue<T, reverse_compare> heap;
+        Compare cmp;
+
+    public:
+        topk() : heap((int) K + 2) {}
+
+        topk(const topk &other) = default;
+
+        topk &operator=(const topk &other) = default;
+
+        /**
+         * offer an element, it is kept only if it is better than the worst of the current K.
+         */
+        void push(const T &e) {
+            if (K == 0)return;
+            if (heap.size() < K)heap.push(e);
+            else if (cmp.operator()(heap.top(), e))heap.replace_top(e);
+        }
+
+        /**
+         * merge the winners of another topk (e.g. the partial result of another thread) into this one.
+         */
+        void merge(const topk &other) {
+            if (this == &other)return;
+            priority_queue<T, reverse_compare> tmp(other.heap);
+            while (!tmp.empty()) {
+                push(tmp.top());
+                tmp.pop();
+            }
+        }
+
+        /**
+         * the worst element that is still kept.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &bottom() const {
+            return heap.top();
+        }
+
+        /**
+         * write the kept elements to out, the best one first.
+         * @return the output iterator past the last written element.
+         */
+        template<class OutputIt>
+        OutputIt sorted(OutputIt out) const {
+            priority_queue<T, reverse_compare> tmp(heap);
+            size_t n = tmp.size();
+            T *buffer = (T *) malloc(sizeof(T) * (n + 1));
+            //出堆的顺序是从差到好，倒着放
+            for (size_t i = n; i > 0; --i) {
+                new(buffer + i - 1)T(tmp.top());
+                tmp.pop();
+            }
+            for (size_t i = 0; i < n; ++i) {
+                *out = buffer[i];
+                ++out;
+                buffer[i].~T();
+            }
+            free((void *) buffer);
+            return out;
+        }
+
+        size_t size() const {
+            return heap.size();
+        }
+
+        bool empty() const {
+            return heap.empty();
+        }
+
+        void clear() {
+            while (!heap.empty())heap.pop();
+        }
+    };
+
+}
+
+#endif